@@ -0,0 +1,196 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace Utils {
+
+	// Lock-free ring with exactly one producer and one consumer thread
+	template<class T>
+	class SpscRing {
+	public:
+		explicit SpscRing(size_t _capacity) : capacity(_capacity), items(_capacity) {}
+
+		bool push(T &&item) {
+			const size_t h = head.load(std::memory_order_relaxed);
+			if(h - tail.load(std::memory_order_acquire) == capacity)
+				return false;
+			items[h % capacity] = std::move(item);
+			head.store(h + 1, std::memory_order_release);
+			return true;
+		}
+
+		template<class Func>
+		void drain(Func consume) {
+			size_t t = tail.load(std::memory_order_relaxed);
+			const size_t h = head.load(std::memory_order_acquire);
+			for(; t != h; t++)
+				consume(std::move(items[t % capacity]));
+			tail.store(t, std::memory_order_release);
+		}
+
+		// Called by the producer once it will never push again
+		void retire() { retired.store(true, std::memory_order_release); }
+		bool isRetired() const { return retired.load(std::memory_order_acquire); }
+
+	private:
+		const size_t capacity;
+		std::vector<T> items;
+		std::atomic<size_t> head{ 0 }, tail{ 0 };
+		std::atomic<bool> retired{ false };
+	};
+
+	// Every producing thread gets its own SpscRing, a background thread drains all rings in batches.
+	// Declare the sink after everything consumeBatch touches, so it is stopped and drained before those are destroyed.
+	template<class T>
+	class AsyncSink {
+	public:
+		using BatchConsumer = std::function<void(std::vector<T> &batch)>;
+		using FlushHandler = std::function<void()>;
+
+		AsyncSink(BatchConsumer _consumeBatch, FlushHandler _flushOutput, size_t _ringCapacity = 4096)
+			: id(nextId()), ringCapacity(_ringCapacity), consumeBatch(_consumeBatch), flushOutput(_flushOutput), writer(&AsyncSink::writerLoop, this) {}
+
+		~AsyncSink() {
+			{
+				std::lock_guard<std::mutex> lock(writerMutex);
+				stopWriter = true;
+			}
+			writerCondition.notify_all();
+			writer.join();
+		}
+
+		void push(T item) {
+			SpscRing<T> &ring = ringOfThisThread();
+			while(!ring.push(std::move(item))) {
+				ringFull = true;
+				writerCondition.notify_one();
+				std::this_thread::yield();
+			}
+		}
+
+		// Blocks until everything pushed before has been consumed and flushOutput was called
+		void flush() {
+			std::unique_lock<std::mutex> lock(writerMutex);
+			const uint64_t request = ++flushRequests;
+			writerCondition.notify_all();
+			writerCondition.wait(lock, [&] { return flushesDone >= request; });
+		}
+
+		// One ring per thread that pushed into this sink and has not exited yet or whose ring was not drained since
+		size_t numRings() {
+			std::lock_guard<std::mutex> lock(ringsMutex);
+			return rings.size();
+		}
+
+	private:
+		const uint64_t id;
+		const size_t ringCapacity;
+		BatchConsumer consumeBatch;
+		FlushHandler flushOutput;
+
+		std::mutex ringsMutex;
+		std::vector<std::shared_ptr<SpscRing<T>>> rings;
+		std::vector<T> batch;
+
+		std::mutex writerMutex;
+		std::condition_variable writerCondition;
+		bool stopWriter = false;
+		std::atomic<bool> ringFull{ false };
+		uint64_t flushRequests = 0, flushesDone = 0;
+		std::thread writer;
+
+		static uint64_t nextId() {
+			static std::atomic<uint64_t> idCounter(0);
+			return idCounter++;
+		}
+
+		struct RingOfThread {
+			SpscRing<T> *ring;
+			std::weak_ptr<SpscRing<T>> owner;
+		};
+
+		// Retires the rings of a thread when it exits, so the writer drops them after draining
+		struct RingsOfThread {
+			std::unordered_map<uint64_t, RingOfThread> bySinkId;
+			~RingsOfThread() {
+				for(auto &entry : bySinkId)
+					if(auto ring = entry.second.owner.lock())
+						ring->retire();
+			}
+		};
+
+		SpscRing<T> &ringOfThisThread() {
+			// Sink ids are never reused, so entries of destroyed sinks cannot match.
+			// They expire with their sink and are pruned whenever the thread registers a new ring.
+			thread_local RingsOfThread ringsOfThread;
+			auto &bySinkId = ringsOfThread.bySinkId;
+			const auto it = bySinkId.find(id);
+			if(it != bySinkId.end())
+				return *it->second.ring;
+
+			for(auto entry = bySinkId.begin(); entry != bySinkId.end();)
+				entry = entry->second.owner.expired() ? bySinkId.erase(entry) : std::next(entry);
+
+			auto ring = std::make_shared<SpscRing<T>>(ringCapacity);
+			{
+				std::lock_guard<std::mutex> lock(ringsMutex);
+				rings.push_back(ring);
+			}
+			bySinkId.emplace(id, RingOfThread{ ring.get(), ring });
+			return *ring;
+		}
+
+		void drainRings() {
+			{
+				std::lock_guard<std::mutex> lock(ringsMutex);
+				for(auto ring = rings.begin(); ring != rings.end();) {
+					// Retirement is checked first, so a retired ring is empty for good after this drain
+					const bool retired = (*ring)->isRetired();
+					(*ring)->drain([&](T &&item) { batch.push_back(std::move(item)); });
+					ring = retired ? rings.erase(ring) : std::next(ring);
+				}
+			}
+			if(!batch.empty()) {
+				consumeBatch(batch);
+				batch.clear();
+			}
+		}
+
+		void writerLoop() {
+			const std::chrono::milliseconds DRAIN_INTERVAL(5);
+			while(true) {
+				uint64_t requestsSeen;
+				bool stopping;
+				{
+					std::unique_lock<std::mutex> lock(writerMutex);
+					writerCondition.wait_for(lock, DRAIN_INTERVAL, [&] { return stopWriter || ringFull || flushRequests > flushesDone; });
+					ringFull = false;
+					requestsSeen = flushRequests;
+					stopping = stopWriter;
+				}
+
+				drainRings();
+
+				if(requestsSeen > flushesDone || stopping) {
+					flushOutput();
+					std::lock_guard<std::mutex> lock(writerMutex);
+					flushesDone = requestsSeen;
+					writerCondition.notify_all();
+				}
+
+				if(stopping) break;
+			}
+		}
+	};
+
+}
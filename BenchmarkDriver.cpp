@@ -0,0 +1,259 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <boost/algorithm/string.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/format.hpp>
+
+#include "BenchmarkDriver.h"
+#include "BranchAndBound.h"
+#include "ProjectWithOvertime.h"
+#include "Runners.h"
+#include "GeneticAlgorithms/TimeWindow.h"
+
+using namespace std;
+
+namespace BenchmarkDriver {
+
+	string Limit::toString() const {
+		return iterLimit != -1 ? to_string(iterLimit) + "schedules" : (boost::format("%.2fsecs") % timeLimit).str();
+	}
+
+	BenchmarkConfig::BenchmarkConfig() : seeds({ 23 }), threadCounts({ 1 }), targetGap(0.01), outPath("benchmark/") {}
+
+	json11::Json BenchmarkConfig::to_json() const {
+		json11::Json::object sets;
+		for(const auto &pair : instanceSets)
+			sets[pair.first] = pair.second;
+		json11::Json::array limitObjs;
+		for(const auto &limit : limits)
+			limitObjs.push_back(limit.iterLimit != -1 ? json11::Json::object { { "iterLimit", limit.iterLimit } } : json11::Json::object { { "timeLimit", limit.timeLimit } });
+		return json11::Json::object {
+			{ "solvers", solvers },
+			{ "instanceSets", sets },
+			{ "limits", limitObjs },
+			{ "seeds", seeds },
+			{ "threadCounts", threadCounts },
+			{ "bestKnownFile", bestKnownFilename },
+			{ "targetGap", targetGap },
+			{ "outPath", outPath },
+			{ "gaParameters", gaParameters }
+		};
+	}
+
+	void BenchmarkConfig::from_json(const json11::Json &obj) {
+		auto strings = [](const json11::Json &arr) {
+			vector<string> strs;
+			for(const auto &item : arr.array_items()) strs.push_back(item.string_value());
+			return strs;
+		};
+
+		if(obj["solvers"].is_array()) solvers = strings(obj["solvers"]);
+		if(obj["instanceSets"].is_object()) {
+			instanceSets.clear();
+			for(const auto &pair : obj["instanceSets"].object_items())
+				instanceSets[pair.first] = strings(pair.second);
+		}
+		if(obj["limits"].is_array()) {
+			limits.clear();
+			for(const auto &item : obj["limits"].array_items())
+				limits.push_back({ item["timeLimit"].is_number() ? item["timeLimit"].number_value() : -1.0, item["iterLimit"].is_number() ? item["iterLimit"].int_value() : -1 });
+		}
+		if(obj["seeds"].is_array()) seeds = JsonUtils::extractIntArrayFromObj(obj, "seeds");
+		if(obj["threadCounts"].is_array()) threadCounts = JsonUtils::extractIntArrayFromObj(obj, "threadCounts");
+		if(obj["bestKnownFile"].is_string()) bestKnownFilename = obj["bestKnownFile"].string_value();
+		if(obj["targetGap"].is_number()) targetGap = obj["targetGap"].number_value();
+		if(obj["outPath"].is_string()) outPath = obj["outPath"].string_value();
+		if(obj["gaParameters"].is_object()) gaParameters = obj["gaParameters"];
+	}
+
+	double gapToBest(float profit, float bestKnown) {
+		return (static_cast<double>(bestKnown) - static_cast<double>(profit)) / max(fabs(static_cast<double>(bestKnown)), 1e-6);
+	}
+
+	double timeToTarget(const vector<Utils::Tracer::TracePoint> &curve, float bestKnown, double targetGap) {
+		for(const auto &point : curve)
+			if(gapToBest(point.bks_objval, bestKnown) <= targetGap)
+				return point.secs;
+		return -1.0;
+	}
+
+	double gapAreaUnderCurve(const vector<Utils::Tracer::TracePoint> &curve, float bestKnown, double horizon) {
+		if(horizon <= 0.0) return curve.empty() ? 1.0 : min(1.0, max(0.0, gapToBest(curve.back().bks_objval, bestKnown)));
+
+		double area = 0.0, lastSecs = 0.0, lastGap = 1.0;
+		for(const auto &point : curve) {
+			const double secs = min(point.secs, horizon);
+			area += (secs - lastSecs) * lastGap;
+			lastSecs = secs;
+			lastGap = min(1.0, max(0.0, gapToBest(point.bks_objval, bestKnown)));
+		}
+		area += (horizon - lastSecs) * lastGap;
+		return area / horizon;
+	}
+
+	namespace {
+		vector<string> instanceFilenames(const vector<string> &paths) {
+			vector<string> filenames;
+			for(const string &path : paths) {
+				if(boost::filesystem::is_directory(path)) {
+					auto inDir = Utils::filenamesInDirWithExt(path, ".sm");
+					vector<string> sorted(inDir.begin(), inDir.end());
+					sort(sorted.begin(), sorted.end());
+					filenames.insert(filenames.end(), sorted.begin(), sorted.end());
+				} else filenames.push_back(path);
+			}
+			return filenames;
+		}
+
+		string coreNameOfFilename(const string &filename) {
+			return boost::filesystem::path(filename).stem().string();
+		}
+
+		map<string, float> readBestKnown(const string &filename) {
+			map<string, float> bestKnown;
+			if(filename.empty()) return bestKnown;
+			for(const string &line : Utils::readLines(filename)) {
+				vector<string> parts;
+				boost::split(parts, line, boost::is_any_of(";"));
+				if(parts.size() >= 2 && !parts[0].empty() && parts[1] != "infes")
+					bestKnown[parts[0]] = stof(parts[1]);
+			}
+			return bestKnown;
+		}
+
+		string configurationKey(const RunRecord &run) {
+			return run.solver + ";" + run.instanceSet + ";" + run.limit.toString() + ";" + to_string(run.threadCount);
+		}
+	}
+
+	RunRecord runSingle(const BenchmarkConfig &config, const string &solver, const string &instanceSet, const string &instanceFilename, const Limit &limit, int seed, int threadCount) {
+		ProjectWithOvertime p(instanceFilename);
+		const string tracePath = config.outPath + "traces/" + solver + "_" + limit.toString() + "_t" + to_string(threadCount) + "_s" + to_string(seed) + "/";
+		boost::filesystem::create_directories(tracePath);
+
+		Utils::seedRandom(static_cast<unsigned int>(seed));
+
+		RunRecord run = { solver, instanceSet, coreNameOfFilename(instanceFilename), limit, seed, threadCount, 0.0f, 0.0, 0, {} };
+		vector<int> sts;
+
+		if(boost::starts_with(solver, "BranchAndBound")) {
+			int strategyThreadCount;
+			const auto strategy = BranchAndBound::strategyFromSuffix(solver.substr(14), strategyThreadCount);
+			BranchAndBound b(p, limit.timeLimit, limit.iterLimit, false, strategy.type == BranchAndBound::Strategy::DepthFirst ? threadCount : 1);
+			b.setStrategy(strategy);
+			Stopwatch sw;
+			sw.start();
+			sts = b.solve(false, true, tracePath);
+			run.solvetime = sw.look() / 1000.0;
+			run.numSchedules = b.getNodeCount();
+			run.anytimeCurve = b.anytimeCurve();
+		} else if(boost::starts_with(solver, "GA")) {
+			const int gaIndex = stoi(solver.substr(2, solver.length() - 2));
+			const int variant = (gaIndex == 0 && solver.length() == 4) ? stoi(solver.substr(3, 1)) : 0;
+			if(gaIndex == 0)
+				TimeWindowBordersGA::setVariant(variant);
+
+			GAParameters params = Runners::defaultParameters();
+			if(config.gaParameters.is_object())
+				params.from_json(config.gaParameters);
+			params.timeLimit = limit.timeLimit;
+			params.iterLimit = limit.iterLimit;
+			params.threadCount = threadCount;
+			params.traceobj = true;
+			params.outPath = tracePath;
+
+			const Runners::GAResult result = Runners::run(p, params, gaIndex);
+			sts = result.sts;
+			run.solvetime = result.solvetime / 1000.0;
+			run.anytimeCurve = result.anytimeCurve;
+			run.numSchedules = run.anytimeCurve.empty() ? 0 : run.anytimeCurve.back().nschedules;
+		} else {
+			throw runtime_error("Unknown benchmark solver: " + solver + "!");
+		}
+
+		run.profit = sts.empty() || sts[0] == Project::UNSCHEDULED ? numeric_limits<float>::lowest() : p.calcProfit(sts);
+		return run;
+	}
+
+	vector<RunRecord> runMatrix(const BenchmarkConfig &config) {
+		vector<RunRecord> runs;
+		for(const auto &set : config.instanceSets) {
+			const vector<string> filenames = instanceFilenames(set.second);
+			for(const string &solver : config.solvers)
+				for(const Limit &limit : config.limits)
+					for(int threadCount : config.threadCounts)
+						for(int seed : config.seeds)
+							for(const string &filename : filenames) {
+								LOG_I("Benchmark run solver=" + solver + " set=" + set.first + " instance=" + filename + " limit=" + limit.toString() + " threads=" + to_string(threadCount) + " seed=" + to_string(seed));
+								runs.push_back(runSingle(config, solver, set.first, filename, limit, seed, threadCount));
+							}
+		}
+		return runs;
+	}
+
+	void writeReport(const BenchmarkConfig &config, const vector<RunRecord> &runs) {
+		map<string, float> bestKnown = readBestKnown(config.bestKnownFilename);
+		for(const auto &run : runs) {
+			if(!config.bestKnownFilename.empty() && bestKnown.count(run.instance)) continue;
+			float &bks = bestKnown.emplace(run.instance, numeric_limits<float>::lowest()).first->second;
+			if(!run.anytimeCurve.empty()) bks = max(bks, run.anytimeCurve.back().bks_objval);
+			bks = max(bks, run.profit);
+		}
+
+		struct Summary {
+			int numRuns = 0, numReached = 0;
+			double gapSum = 0.0, maxGap = 0.0, tttSum = 0.0, schedulesPerSecSum = 0.0, aucSum = 0.0;
+		};
+		map<string, Summary> summaries;
+
+		stringstream runsCsv;
+		runsCsv << "solver;instanceSet;instance;limit;threads;seed;profit;bestKnown;gap;timeToTarget;schedulesPerSec;gapAuc;solvetime\n";
+		for(const auto &run : runs) {
+			const float bks = bestKnown[run.instance];
+			const double gap = gapToBest(run.profit, bks);
+			const double ttt = timeToTarget(run.anytimeCurve, bks, config.targetGap);
+			const double schedulesPerSec = run.solvetime > 0.0 ? run.numSchedules / run.solvetime : 0.0;
+			const double horizon = run.limit.timeLimit > 0.0 ? run.limit.timeLimit : run.solvetime;
+			const double auc = gapAreaUnderCurve(run.anytimeCurve, bks, horizon);
+
+			runsCsv << run.solver << ";" << run.instanceSet << ";" << run.instance << ";" << run.limit.toString() << ";" << run.threadCount << ";" << run.seed << ";"
+					<< run.profit << ";" << bks << ";" << gap << ";" << ttt << ";" << schedulesPerSec << ";" << auc << ";" << run.solvetime << "\n";
+
+			Summary &summary = summaries[configurationKey(run)];
+			summary.numRuns++;
+			summary.gapSum += gap;
+			summary.maxGap = max(summary.maxGap, gap);
+			if(ttt >= 0.0) {
+				summary.numReached++;
+				summary.tttSum += ttt;
+			}
+			summary.schedulesPerSecSum += schedulesPerSec;
+			summary.aucSum += auc;
+		}
+
+		stringstream reportCsv;
+		reportCsv << "solver;instanceSet;limit;threads;runs;meanGap;maxGap;reachedTarget;meanTimeToTarget;meanSchedulesPerSec;meanGapAuc\n";
+		for(const auto &pair : summaries) {
+			const Summary &s = pair.second;
+			const string line = pair.first + ";" + to_string(s.numRuns) + ";" + to_string(s.gapSum / s.numRuns) + ";" + to_string(s.maxGap) + ";"
+								+ to_string(s.numReached) + ";" + (s.numReached > 0 ? to_string(s.tttSum / s.numReached) : "-") + ";"
+								+ to_string(s.schedulesPerSecSum / s.numRuns) + ";" + to_string(s.aucSum / s.numRuns);
+			reportCsv << line << "\n";
+			LOG_I(line);
+		}
+
+		boost::filesystem::create_directories(config.outPath);
+		Utils::spit(runsCsv.str(), config.outPath + "BenchmarkRuns.csv");
+		Utils::spit(reportCsv.str(), config.outPath + "BenchmarkReport.csv");
+	}
+
+	void runFromConfigFile(const string &configFilename) {
+		BenchmarkConfig config;
+		config.from_disk(configFilename);
+		if(config.limits.empty())
+			config.limits.push_back({ -1.0, 1000 });
+		writeReport(config, runMatrix(config));
+	}
+}
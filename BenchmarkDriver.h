@@ -0,0 +1,61 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "JsonUtils.h"
+#include "Logger.h"
+
+// Runs a matrix of solver configurations on local instance sets and reports anytime quality per configuration.
+// Example config:
+// { "solvers": ["GA3", "GA01", "BranchAndBound", "BranchAndBoundBeam64"], "instanceSets": { "j30": ["Data/j3025_4.sm", "j30/"] },
+//   "limits": [ { "iterLimit": 5000 }, { "timeLimit": 1.0 } ], "seeds": [1, 2], "threadCounts": [1],
+//   "bestKnownFile": "j30opt.txt", "targetGap": 0.01, "outPath": "benchmark/", "gaParameters": { "popSize": 80 } }
+namespace BenchmarkDriver {
+
+	struct Limit {
+		double timeLimit;
+		int iterLimit;
+		std::string toString() const;
+	};
+
+	struct BenchmarkConfig : JsonUtils::IJsonSerializable {
+		std::vector<std::string> solvers;
+		std::map<std::string, std::vector<std::string>> instanceSets;
+		std::vector<Limit> limits;
+		std::vector<int> seeds, threadCounts;
+		// Lines coreName;profit like the solver result files, best profit over all runs is used for missing instances
+		std::string bestKnownFilename;
+		double targetGap;
+		std::string outPath;
+		json11::Json gaParameters;
+
+		BenchmarkConfig();
+		json11::Json to_json() const override;
+		void from_json(const json11::Json &obj) override;
+	};
+
+	struct RunRecord {
+		std::string solver, instanceSet, instance;
+		Limit limit;
+		int seed, threadCount;
+		float profit;
+		double solvetime;
+		int numSchedules;
+		std::vector<Utils::Tracer::TracePoint> anytimeCurve;
+	};
+
+	// Relative distance of profit to the best known profit, 0 is optimal
+	double gapToBest(float profit, float bestKnown);
+	// Solver time in secs when the curve first came within targetGap of the best known profit, -1 if never
+	double timeToTarget(const std::vector<Utils::Tracer::TracePoint> &curve, float bestKnown, double targetGap);
+	// Integral of the gap (1 while no solution is known, capped at 1) over [0, horizon] divided by horizon
+	double gapAreaUnderCurve(const std::vector<Utils::Tracer::TracePoint> &curve, float bestKnown, double horizon);
+
+	RunRecord runSingle(const BenchmarkConfig &config, const std::string &solver, const std::string &instanceSet, const std::string &instanceFilename, const Limit &limit, int seed, int threadCount);
+	std::vector<RunRecord> runMatrix(const BenchmarkConfig &config);
+	void writeReport(const BenchmarkConfig &config, const std::vector<RunRecord> &runs);
+
+	void runFromConfigFile(const std::string &configFilename);
+}
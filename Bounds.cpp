@@ -0,0 +1,208 @@
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+#include "Bounds.h"
+#include "ProjectWithOvertime.h"
+#include "Utils.h"
+
+using namespace std;
+
+Bounds::Bounds(const ProjectWithOvertime &_p) : p(_p), tails(_p.numJobs, 0),
+	horizon(Utils::max(_p.numPeriods, accumulate(_p.durations.begin(), _p.durations.end(), 0) + 1)) {
+	for(int j : p.revTopOrder) {
+		tails[j] = p.durations[j];
+		for(int k : p.succs[j])
+			tails[j] = Utils::max(tails[j], p.durations[j] + tails[k]);
+	}
+}
+
+int Bounds::capacity(int r, bool withOvertime) const {
+	return p.capacities[r] + (withOvertime ? p.zmax[r] : 0);
+}
+
+int Bounds::criticalPathMakespan() const {
+	return tails[0];
+}
+
+int Bounds::energyMakespan(bool withOvertime) const {
+	int msLb = 0;
+	for(int r = 0; r < p.numRes; r++) {
+		const int cap = capacity(r, withOvertime);
+		int work = 0;
+		for(int j = 0; j < p.numJobs; j++)
+			work += p.durations[j] * p.demands(j, r);
+		if(cap <= 0) {
+			if(work > 0) return numeric_limits<int>::max();
+			continue;
+		}
+		msLb = Utils::max(msLb, (work + cap - 1) / cap);
+	}
+	return msLb;
+}
+
+bool Bounds::incompatible(int i, int j, bool withOvertime) const {
+	if(p.adjMx(i, j) || p.adjMx(j, i))
+		return true;
+	for(int r = 0; r < p.numRes; r++)
+		if(p.demands(i, r) + p.demands(j, r) > capacity(r, withOvertime))
+			return true;
+	return false;
+}
+
+int Bounds::incompatibleSetMakespan(bool withOvertime) const {
+	vector<int> jobs(static_cast<size_t>(p.numJobs));
+	iota(jobs.begin(), jobs.end(), 0);
+	stable_sort(jobs.begin(), jobs.end(), [this](int i, int j) { return p.durations[i] > p.durations[j]; });
+
+	vector<int> chosen;
+	int msLb = 0;
+	for(int j : jobs) {
+		if(p.durations[j] == 0) break;
+		if(all_of(chosen.begin(), chosen.end(), [&](int i) { return incompatible(i, j, withOvertime); })) {
+			chosen.push_back(j);
+			msLb += p.durations[j];
+		}
+	}
+	return msLb;
+}
+
+int Bounds::makespanLowerBound(bool withOvertime) const {
+	return Utils::max(criticalPathMakespan(), Utils::max(energyMakespan(withOvertime), incompatibleSetMakespan(withOvertime)));
+}
+
+float Bounds::overtimeCostsLowerBound(int ms) const {
+	float costsLb = 0.0f;
+	for(int r = 0; r < p.numRes; r++) {
+		vector<int> compulsoryDemandDelta(static_cast<size_t>(ms + 2), 0);
+		int work = 0;
+		for(int j = 0; j < p.numJobs; j++) {
+			work += p.durations[j] * p.demands(j, r);
+			const int lstj = ms - tails[j];
+			const int eftj = p.ests[j] + p.durations[j];
+			if(lstj < eftj) {
+				compulsoryDemandDelta[Utils::max(0, lstj + 1)] += p.demands(j, r);
+				compulsoryDemandDelta[Utils::min(ms + 1, eftj + 1)] -= p.demands(j, r);
+			}
+		}
+
+		int compulsoryDemand = 0, compulsoryOvertime = 0;
+		for(int t = 1; t <= ms; t++) {
+			compulsoryDemand += compulsoryDemandDelta[t];
+			if(compulsoryDemand > capacity(r, true))
+				return numeric_limits<float>::max();
+			compulsoryOvertime += Utils::max(0, compulsoryDemand - p.capacities[r]);
+		}
+
+		costsLb += p.kappa[r] * Utils::max(compulsoryOvertime, work - p.capacities[r] * ms);
+	}
+	return costsLb;
+}
+
+vector<float> Bounds::profitUpperBounds() const {
+	vector<float> bounds(p.revenue.size(), numeric_limits<float>::lowest());
+	float bestBound = numeric_limits<float>::lowest();
+	for(int ms = makespanLowerBound(); ms < static_cast<int>(p.revenue.size()); ms++) {
+		const float costsLb = overtimeCostsLowerBound(ms);
+		if(costsLb != numeric_limits<float>::max())
+			bestBound = max(bestBound, p.revenue[ms] - costsLb);
+		bounds[ms] = bestBound;
+	}
+	return bounds;
+}
+
+// Stops as soon as the revenue alone cannot beat the best bound
+float Bounds::profitUpperBound() const {
+	float bestBound = numeric_limits<float>::lowest();
+	for(int ms = makespanLowerBound(); ms < static_cast<int>(p.revenue.size()) && p.revenue[ms] > bestBound; ms++) {
+		const float costsLb = overtimeCostsLowerBound(ms);
+		if(costsLb != numeric_limits<float>::max())
+			bestBound = max(bestBound, p.revenue[ms] - costsLb);
+	}
+	return bestBound;
+}
+
+Bounds::Profile Bounds::emptyProfile() const {
+	Profile profile;
+	profile.cumulativeDemand = Matrix<int>(p.numRes, horizon + 1, 0);
+	profile.overtime.assign(p.numRes, 0);
+	profile.missingWork.assign(p.numRes, 0);
+	for(int j = 0; j < p.numJobs; j++)
+		for(int r = 0; r < p.numRes; r++)
+			profile.missingWork[r] += p.durations[j] * p.demands(j, r);
+	return profile;
+}
+
+void Bounds::fixJob(Profile &profile, int j, int stj) const {
+	for(int r = 0; r < p.numRes; r++) {
+		if(p.demands(j, r) == 0) continue;
+		profile.missingWork[r] -= p.durations[j] * p.demands(j, r);
+		for(int tau = stj + 1; tau <= stj + p.durations[j]; tau++) {
+			int &cdemand = profile.cumulativeDemand(r, tau);
+			profile.overtime[r] -= Utils::max(0, cdemand - p.capacities[r]);
+			cdemand += p.demands(j, r);
+			profile.overtime[r] += Utils::max(0, cdemand - p.capacities[r]);
+		}
+	}
+}
+
+void Bounds::releaseJob(Profile &profile, int j, int stj) const {
+	for(int r = 0; r < p.numRes; r++) {
+		if(p.demands(j, r) == 0) continue;
+		profile.missingWork[r] += p.durations[j] * p.demands(j, r);
+		for(int tau = stj + 1; tau <= stj + p.durations[j]; tau++) {
+			int &cdemand = profile.cumulativeDemand(r, tau);
+			profile.overtime[r] -= Utils::max(0, cdemand - p.capacities[r]);
+			cdemand -= p.demands(j, r);
+			profile.overtime[r] += Utils::max(0, cdemand - p.capacities[r]);
+		}
+	}
+}
+
+float Bounds::costs(const Profile &profile) const {
+	float costs = 0.0f;
+	for(int r = 0; r < p.numRes; r++)
+		costs += static_cast<float>(profile.overtime[r]) * p.kappa[r];
+	return costs;
+}
+
+float Bounds::partialProfitUpperBound(const Profile &profile, int msMin, int earliestStart) const {
+	const int lastMs = Utils::min(static_cast<int>(p.revenue.size()) - 1, horizon);
+	const float fixedCosts = costs(profile);
+
+	// normal capacity left and overtime capacity left by the fixed jobs in (earliestStart, ms]
+	vector<int> freeArea(static_cast<size_t>(p.numRes), 0), overtimeArea(static_cast<size_t>(p.numRes), 0);
+	const auto addPeriod = [&](int tau) {
+		for(int r = 0; r < p.numRes; r++) {
+			const int cdemand = profile.cumulativeDemand(r, tau);
+			freeArea[r] += Utils::max(0, p.capacities[r] - cdemand);
+			overtimeArea[r] += Utils::max(0, capacity(r, true) - Utils::max(cdemand, p.capacities[r]));
+		}
+	};
+
+	for(int tau = earliestStart + 1; tau <= Utils::min(msMin, lastMs); tau++)
+		addPeriod(tau);
+
+	float bestBound = numeric_limits<float>::lowest();
+	for(int ms = msMin; ms <= lastMs; ms++) {
+		if(ms > msMin && ms > earliestStart) addPeriod(ms);
+
+		bool feasible = true, covered = true;
+		float additionalCosts = 0.0f;
+		for(int r = 0; r < p.numRes; r++) {
+			const int excess = profile.missingWork[r] - freeArea[r];
+			if(excess <= 0) continue;
+			covered = false;
+			if(excess > overtimeArea[r]) feasible = false;
+			additionalCosts += static_cast<float>(excess) * p.kappa[r];
+		}
+
+		if(feasible)
+			bestBound = max(bestBound, p.revenue[ms] - fixedCosts - additionalCosts);
+
+		// a later makespan only lowers the revenue
+		if(covered) break;
+	}
+
+	return bestBound;
+}
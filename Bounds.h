@@ -0,0 +1,55 @@
+#pragma once
+
+#include <vector>
+
+#include "Matrix.h"
+
+class ProjectWithOvertime;
+
+// Makespan lower bounds and profit upper bounds of a project with overtime for complete and partial schedules.
+// Makespan bounds with overtime use the capacities extended by zmax, bounds without overtime the normal capacities.
+// Profit bounds assume the revenue to be non-increasing in the makespan.
+class Bounds {
+public:
+	explicit Bounds(const ProjectWithOvertime &_p);
+
+	// Longest path from start of job to start of the sink
+	const std::vector<int> &getTails() const { return tails; }
+
+	int criticalPathMakespan() const;
+	// Total work of each resource divided by its capacity
+	int energyMakespan(bool withOvertime) const;
+	// Sum of durations of a greedy set of pairwise incompatible jobs, no two of them can overlap due to an arc or their demands
+	int incompatibleSetMakespan(bool withOvertime) const;
+	int makespanLowerBound(bool withOvertime = true) const;
+
+	// Overtime costs lower bound for makespan ms from the work exceeding the normal capacity area and from the
+	// compulsory parts of the jobs for deadline ms, max float if ms is infeasible
+	float overtimeCostsLowerBound(int ms) const;
+	// Entry ms bounds the profit of any schedule with makespan at most ms
+	std::vector<float> profitUpperBounds() const;
+	float profitUpperBound() const;
+
+	// Demand profile of the fixed jobs of a partial schedule, updated when jobs are fixed and released
+	struct Profile {
+		Matrix<int> cumulativeDemand;
+		// Overtime of the fixed jobs and remaining work of the unfixed jobs per resource
+		std::vector<int> overtime, missingWork;
+	};
+
+	Profile emptyProfile() const;
+	void fixJob(Profile &profile, int j, int stj) const;
+	void releaseJob(Profile &profile, int j, int stj) const;
+	float costs(const Profile &profile) const;
+	// Bounds the profit of all completions with makespan at least msMin whose unfixed jobs start at earliestStart or later.
+	// The missing work has to fit into the free capacity after earliestStart or causes additional overtime.
+	float partialProfitUpperBound(const Profile &profile, int msMin, int earliestStart) const;
+
+private:
+	const ProjectWithOvertime &p;
+	std::vector<int> tails;
+	int horizon;
+
+	bool incompatible(int i, int j, bool withOvertime) const;
+	int capacity(int r, bool withOvertime) const;
+};
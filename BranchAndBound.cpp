@@ -3,21 +3,41 @@
 #include <map>
 #include <cmath>
 #include <fstream>
+#include <thread>
+#include <queue>
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/filesystem.hpp>
 
 #include "BranchAndBound.h"
 #include "Utils.h"
 #include "Logger.h"
 #include "ProjectWithOvertime.h"
+#include "LagrangianRelaxation.h"
+#include "Checkpoint.h"
 #include "GeneticAlgorithms/OvertimeBound.h"
+#include "GeneticAlgorithms/PriorityRules.h"
 
 using namespace std;
 
-BranchAndBound::BranchAndBound(ProjectWithOvertime& _p, double _timeLimit, int _iterLimit, bool _writeGraph)
-	: p(_p), lb(std::numeric_limits<float>::lowest()), nodeCtr(0), boundCtr(0), writeGraph(_writeGraph), timeLimit(_timeLimit), iterLimit(_iterLimit), tr(nullptr) {}
+const int NUM_BIASED_PASSES_PER_RULE = 4;
+const size_t DEFAULT_TT_BUDGET_BYTES = 64 * 1024 * 1024;
+const uint32_t CHECKPOINT_VERSION = 1;
+
+BranchAndBound::BranchAndBound(ProjectWithOvertime& _p, double _timeLimit, int _iterLimit, bool _writeNodeLog, int _threadCount)
+	: p(_p), bounds(_p), lb(std::numeric_limits<float>::lowest()), nodeCtr(0), boundCtr(0), dominanceCtr(0), upperBound(std::numeric_limits<float>::max()), writeNodeLog(_writeNodeLog), propagation(false), edgeFinding(false), resumed(false), deadline(0), lagrangianIterations(0), timeLimit(_timeLimit), iterLimit(_iterLimit),
+	  threadCount(Utils::max(1, _threadCount)), tr(nullptr), ttBudgetBytes(DEFAULT_TT_BUDGET_BYTES), checkpointInterval(600.0), lastCheckpointTime(0.0), tails(bounds.getTails()), numPendingTasks(0), numIdleWorkers(0), aborted(false) {}
 
 BranchAndBound::~BranchAndBound() {
 }
 
+vector<Utils::Tracer::TracePoint> BranchAndBound::anytimeCurve() const {
+	return tr != nullptr ? tr->anytimeCurve() : vector<Utils::Tracer::TracePoint>();
+}
+
+TranspositionTable::Statistics BranchAndBound::getTranspositionStatistics() const {
+	return tt != nullptr ? tt->getStatistics() : TranspositionTable::Statistics { 0, 0, 0, 0, 0 };
+}
+
 vector<int> BranchAndBound::solve(bool seedWithGA, bool traceobj, const string &outPath) {
     if(traceobj && tr == nullptr) {
         tr = std::make_unique<Utils::Tracer>(getTraceFilename(outPath, p.instanceName));
@@ -25,264 +45,843 @@ vector<int> BranchAndBound::solve(bool seedWithGA, bool traceobj, const string &
 
     //lupdate = chrono::system_clock::now();
     sw.start();
-    
-	if (seedWithGA) {
+
+	if(!checkpointFilename.empty() && (strategyParams.type != Strategy::DepthFirst || threadCount > 1))
+		throw runtime_error("Only the sequential depth-first search supports checkpoints!");
+	resumed = !checkpointFilename.empty() && boost::filesystem::is_regular_file(checkpointFilename);
+
+	if(resumed) {
+		std::cout << "Resuming from checkpoint " << checkpointFilename << std::endl;
+	} else if (seedWithGA) {
 		FixedCapacityGA ga(p);
 		auto res = ga.solve();
 		candidate = res.first;
 		lb = res.second;
-		std::cout << std::endl << "Lower bound seeded by genetic algorithm = " << lb << std::endl;
+		std::cout << std::endl << "Lower bound seeded by genetic algorithm = " << lb.load() << std::endl;
 	} else {
         candidate = p.serialSGS(p.topOrder);
         lb = p.calcProfit(candidate);
+
+        PriorityRules rules(p);
+        for(const auto &order : rules.multiPassSample(rules.numRules() * NUM_BIASED_PASSES_PER_RULE, threadCount)) {
+            vector<int> sts = p.serialSGS(order);
+            float profit = p.calcProfit(sts);
+            if(profit > lb) {
+                candidate = sts;
+                lb = profit;
+            }
+        }
     }
 
 	nodeCtr = 0;
 	boundCtr = 0;
+	dominanceCtr = 0;
+	aborted = false;
+	// limited discrepancy search revisits states on purpose
+	tt = ttBudgetBytes > 0 && strategyParams.type != Strategy::LimitedDiscrepancy ? make_unique<TranspositionTable>(ttBudgetBytes) : nullptr;
+
+	nodeLog = writeNodeLog ? make_unique<NodeLog>(getNodeLogFilename(outPath, p.instanceName)) : nullptr;
 
-	graphPreamble();
+	initJobAttributes();
+	lastCheckpointTime = sw.look();
 
-	vector<int> sts(p.numJobs, Project::UNSCHEDULED);
-	branch(sts, 0, 0);
+	if(resumed) {
+		readCheckpoint();
+	} else {
+		upperBound = rootUpperBound();
+
+		// a makespan whose revenue does not exceed the lower bound cannot improve it
+		deadline = static_cast<int>(p.revenue.size()) - 1;
+		while(deadline > 0 && p.revenue[deadline] <= lb)
+			deadline--;
+	}
+
+	// no search is needed if the root bound proves the initial solution optimal
+	if(upperBound > lb) {
+		switch(strategyParams.type) {
+			case Strategy::BestFirst: bestFirstSearch(); break;
+			case Strategy::Beam: beamSearch(); break;
+			case Strategy::LimitedDiscrepancy: limitedDiscrepancySearch(); break;
+			default:
+				if(threadCount > 1) parallelSearch();
+				else search();
+		}
+	} else {
+		boundCtr++;
+		upperBound = lb;
+	}
+
+	const bool exact = strategyParams.type == Strategy::DepthFirst || strategyParams.type == Strategy::BestFirst;
+	if(exact && !aborted)
+		upperBound = lb;
+	if(!checkpointFilename.empty() && !aborted)
+		boost::filesystem::remove(checkpointFilename);
     
     double solvetime = sw.look();
 
 	std::cout << "Number of nodes visited: " << nodeCtr << std::endl;
 	std::cout << "Number of boundings: " << boundCtr << std::endl;
+	std::cout << "Number of dominance prunings: " << dominanceCtr << std::endl;
+	std::cout << "Upper bound: " << upperBound << std::endl;
+	if(tt != nullptr) {
+		const auto stats = tt->getStatistics();
+		std::cout << "Transposition table: lookups=" << stats.lookups << " hits=" << stats.hits << " prunes=" << stats.prunes
+				  << " stores=" << stats.stores << " replacements=" << stats.replacements << std::endl;
+	}
 	std::cout << "Total solvetime: " << solvetime << std::endl;
 
-	drawGraph();
+	if(nodeLog != nullptr) {
+		std::cout << "Node log records: " << nodeLog->getRecordCount() << std::endl;
+		nodeLog.reset();
+	}
 
 	return candidate;
 }
 
-bool BranchAndBound::isEligible(const vector<int> &sts, int j) const {
-    if(sts[j] != Project::UNSCHEDULED)
-        return false;
+void BranchAndBound::initPartialSchedule(PartialSchedule &partial) const {
+	partial.sts.assign(p.numJobs, Project::UNSCHEDULED);
+	partial.numUnscheduledPreds = Utils::constructVector<int>(p.numJobs, [this](int j) { return static_cast<int>(p.preds[j].size()); });
+	partial.profile = bounds.emptyProfile();
+	partial.makespanLb = 0;
+	partial.trail.clear();
+	partial.propagator = propagation ? make_unique<Propagator>(p, deadline, edgeFinding) : nullptr;
+}
 
-	for (int i = 0; i < p.numJobs; i++)
-		if(p.adjMx(i,j) && sts[i] == Project::UNSCHEDULED)
-			return false;
+void BranchAndBound::scheduleJob(PartialSchedule &partial, int j, int stj) const {
+	partial.trail.emplace_back(j, partial.makespanLb);
+	partial.sts[j] = stj;
+	partial.makespanLb = Utils::max(partial.makespanLb, stj + tails[j]);
+	for(int k : p.succs[j])
+		partial.numUnscheduledPreds[k]--;
+	bounds.fixJob(partial.profile, j, stj);
+	if(partial.propagator != nullptr)
+		partial.propagator->fix(j, stj);
+}
 
-	return true;
+void BranchAndBound::unscheduleLastJob(PartialSchedule &partial) const {
+	const int j = partial.trail.back().first, stj = partial.sts[j];
+	if(partial.propagator != nullptr)
+		partial.propagator->undo();
+	bounds.releaseJob(partial.profile, j, stj);
+	for(int k : p.succs[j])
+		partial.numUnscheduledPreds[k]++;
+	partial.makespanLb = partial.trail.back().second;
+	partial.sts[j] = Project::UNSCHEDULED;
+	partial.trail.pop_back();
 }
 
-pair<bool,bool> BranchAndBound::resourceFeasibilityCheck(vector<int>& sts, int j, int stj) const {
+// Brings the partial schedule to the node of path without its last decision, keeping the common prefix
+void BranchAndBound::restorePathPrefix(PartialSchedule &partial, const vector<pair<int, int>> &path) const {
+	const size_t prefixLength = path.size() - 1;
+	size_t common = 0;
+	while(common < partial.trail.size() && common < prefixLength
+		  && partial.trail[common].first == path[common].first && partial.sts[path[common].first] == path[common].second)
+		common++;
+	while(partial.trail.size() > common)
+		unscheduleLastJob(partial);
+	for(size_t i = common; i < prefixLength; i++)
+		scheduleJob(partial, path[i].first, path[i].second);
+}
+
+void BranchAndBound::initJobAttributes() {
+	topRanks.assign(p.numJobs, 0);
+	for(int i = 0; i < p.numJobs; i++)
+		topRanks[p.topOrder[i]] = i;
+}
+
+bool BranchAndBound::isEligible(const PartialSchedule &partial, int j) const {
+	return partial.sts[j] == Project::UNSCHEDULED && partial.numUnscheduledPreds[j] == 0;
+}
+
+pair<bool,bool> BranchAndBound::resourceFeasibilityCheck(const PartialSchedule &partial, int j, int stj, float &costsWithJob) const {
 	bool feasWoutOC = true;
+	costsWithJob = 0.0f;
 	for(int r = 0; r < p.numRes; r++) {
+		int overtime = partial.profile.overtime[r];
 		for(int tau = stj + 1; tau <= stj + p.durations[j]; tau++) {
-			int cdemand = 0;
-			for(int i = 0; i < p.numJobs; i++)
-				if (sts[i] != Project::UNSCHEDULED && sts[i] < tau && tau <= sts[i] + p.durations[i])
-					cdemand += p.demands(i, r);
-
-			cdemand += p.demands(j, r);
+			const int cdemandBefore = partial.profile.cumulativeDemand(r, tau), cdemand = cdemandBefore + p.demands(j, r);
 
 			if(cdemand > p.capacities[r] + p.zmax[r])
 				return std::make_pair(false, false);
 
-			if(feasWoutOC && cdemand > p.capacities[r])
+			if(cdemand > p.capacities[r]) {
 				feasWoutOC = false;
+				overtime += cdemand - Utils::max(cdemandBefore, p.capacities[r]);
+			}
 		}
+		costsWithJob += static_cast<float>(overtime) * p.kappa[r];
 	}
 	return std::make_pair(true, feasWoutOC);
 }
 
-struct BranchAndBound::AreaData {
-    vector<int> missingDemand, freeArea, overtime;
-    AreaData(Project &p) : missingDemand(p.numRes), freeArea(p.numRes), overtime(p.numRes) {}
-};
+void BranchAndBound::foundLeaf(vector<int> &sts) {
+    sts[p.lastJob] = 0;
+    p.eachJobConst([&](int i) {
+        if(i < p.lastJob)
+            sts[p.lastJob] = Utils::max(sts[i] + p.durations[i], sts[p.lastJob]);
+    });
+    float profit = p.calcProfit(sts);
+    lock_guard<mutex> lock(candidateMutex);
+    if(profit > lb) {
+        candidate = sts;
+        lb = profit;
+        std::cout << "Updated lower bound = " << profit << std::endl;
+		//if(tr != nullptr) tr->trace(sw.look(), lb);
+    }
+}
 
-float BranchAndBound::upperBoundForPartial(const vector<int>& sts) const {
-	Matrix<int> resRem = p.resRemForPartial(sts);
-	Matrix<int> resRemCp = resRem;
+bool BranchAndBound::limitReached() {
+	if(!aborted && timeLimit != -1.0 && sw.look() >= timeLimit * 1000.0)
+		aborted = true;
+	return aborted;
+}
 
-	int msMin = p.makespan(p.earliestStartingTimesForPartial(sts));
-	int msMax = p.makespan(p.serialSGSForPartial(sts, p.topOrder, resRem).first);
+BranchAndBound::Worker &BranchAndBound::singleWorker() {
+	workers.clear();
+	workers.push_back(make_unique<Worker>());
+	initPartialSchedule(workers[0]->partial);
+	return *workers[0];
+}
 
-    AreaData data = computeAreas(sts, resRemCp, 0, msMin);
+float BranchAndBound::rootUpperBound() {
+	const float ub = bounds.profitUpperBound();
+	if(lagrangianIterations <= 0) return ub;
+	LagrangianRelaxation relaxation(p);
+	return min(ub, relaxation.profitUpperBound(lb, lagrangianIterations));
+}
 
-    return Utils::maxInRangeIncl(msMin, msMax, [&](int ms) { return p.revenue[ms] - costsLbForMakespan(msMin, data.missingDemand, data.freeArea, data.overtime, ms); });
+void BranchAndBound::search() {
+	if(resumed) expandStack(*workers[0]);
+	else depthFirstSearch(singleWorker(), 0, 0, 0, upperBound);
 }
 
-float BranchAndBound::costsLbForMakespan(int msMin, const vector<int> &missingDemand, const vector<int> &freeArea, vector<int> &overtime, int ms) const {
-    float costs = 0.0f;
-    for (int r = 0; r < p.numRes; r++) {
-        costs += p.kappa[r] * Utils::max(0, overtime[r] + missingDemand[r] - (freeArea[r] + (ms - msMin) * p.capacities[r]));
-    }
-    return costs;
-}
-
-BranchAndBound::AreaData BranchAndBound::computeAreas(const vector<int> &sts, const Matrix<int> &resRem, int tmin, int tmax) const {
-    AreaData data(p);
-    for (int r = 0; r < p.numRes; r++) {
-		data.missingDemand[r] = 0;
-		for (int j = 0; j < p.numJobs; j++)
-			if (sts[j] == Project::UNSCHEDULED)
-                data.missingDemand[r] += p.demands(j, r) * p.durations[j];
-
-        data.freeArea[r] = 0;
-        data.overtime[r] = 0;
-        for (int t = tmin; t <= tmax; t++) {
-            data.freeArea[r] += Utils::max(0, resRem(r, t));
-            data.overtime[r] += Utils::max(0, -resRem(r, t));
-        }
+void BranchAndBound::parallelSearch() {
+	workers.clear();
+	for(int i = 0; i < threadCount; i++) {
+		workers.push_back(make_unique<Worker>());
+		initPartialSchedule(workers[i]->partial);
 	}
-    return data;
-}
 
-float BranchAndBound::upperBoundForPartialSimple(const vector<int> &sts) const {
-    return p.revenue[p.makespan(p.earliestStartingTimesForPartial(sts))] - p.totalCostsForPartial(sts);
+	workers[0]->tasks.push_back({ { { 0, 0 } }, upperBound, 0 });
+	numPendingTasks = 1;
+	numIdleWorkers = 0;
+
+	vector<thread> threads;
+	for(int i = 0; i < threadCount; i++)
+		threads.emplace_back([this, i] { runWorker(i); });
+	for(auto &t : threads)
+		t.join();
 }
 
-float BranchAndBound::upperBoundForPartial2(const vector<int> &sts) const {
-    Matrix<int> resRem = p.resRemForPartial(sts);
-    float fixedCosts = p.totalCostsForPartial(sts);
+void BranchAndBound::runWorker(int workerIx) {
+	Worker &worker = *workers[workerIx];
+	bool idle = false;
+	Task task;
 
-	vector<int> essFeas = p.earliestStartingTimesForPartialRespectZmax(sts, resRem);
+	while(!aborted && numPendingTasks > 0) {
+		if(!popTask(workerIx, task)) {
+			if(!idle) {
+				idle = true;
+				numIdleWorkers++;
+			}
+			this_thread::yield();
+			limitReached();
+			continue;
+		}
+
+		if(idle) {
+			idle = false;
+			numIdleWorkers--;
+		}
+
+		// the incumbent may have improved since the task was created
+		if(task.ub > lb) {
+			restorePathPrefix(worker.partial, task.path);
+			depthFirstSearch(worker, task.parentIx, task.path.back().first, task.path.back().second, task.ub);
+		} else {
+			boundCtr++;
+			logNode(-1, task.parentIx, task.path.back().first, task.path.back().second, task.ub, NodeLog::Reason::Bound);
+		}
 
-	int minStUnscheduled = std::numeric_limits<int>::max();
-	for (int j = 0; j < p.numJobs; j++) {
-		if (sts[j] == Project::UNSCHEDULED && essFeas[j] < minStUnscheduled)
-			minStUnscheduled = essFeas[j];
+		numPendingTasks--;
 	}
 
-    int essFeasMakespan = p.makespan(essFeas);
+	if(idle) numIdleWorkers--;
+}
 
-    AreaData data = computeAreas(sts, resRem, minStUnscheduled, essFeasMakespan);
+bool BranchAndBound::popTask(int workerIx, Task &task) {
+	{
+		Worker &own = *workers[workerIx];
+		lock_guard<mutex> lock(own.tasksMutex);
+		if(!own.tasks.empty()) {
+			task = move(own.tasks.back());
+			own.tasks.pop_back();
+			return true;
+		}
+	}
 
-    float bestProfit = std::numeric_limits<float>::lowest();
-    int delayPeriods = 0;
+	for(int offset = 1; offset < threadCount; offset++) {
+		Worker &victim = *workers[(workerIx + offset) % threadCount];
+		lock_guard<mutex> lock(victim.tasksMutex);
+		if(!victim.tasks.empty()) {
+			task = move(victim.tasks.front());
+			victim.tasks.pop_front();
+			return true;
+		}
+	}
 
-    while(true) {
-        float additionalCostsLb = 0.0f;
-        for (int r = 0; r < p.numRes; r++) {
-            additionalCostsLb += static_cast<float>(fmax(0, data.missingDemand[r] - (data.freeArea[r] + p.capacities[r] * delayPeriods))) * p.kappa[r];
-        }
+	return false;
+}
 
-        float profit = p.revenue[essFeasMakespan + delayPeriods] - (fixedCosts + additionalCostsLb);
-        bestProfit = fmax(profit, bestProfit);
+// Hands all but the best child of the frame to idle workers through the own deque
+void BranchAndBound::shareChildren(Worker &worker, Frame &frame) {
+	if(numIdleWorkers == 0 || frame.children.size() <= 1) return;
 
-        if(fabs(additionalCostsLb - 0.0f) < 0.0000001f) {
-            break;
-        }
+	lock_guard<mutex> lock(worker.tasksMutex);
+	if(!worker.tasks.empty()) return;
 
-        delayPeriods++;
-    }
+	vector<pair<int, int>> path;
+	for(const auto &decision : worker.partial.trail)
+		path.emplace_back(decision.first, worker.partial.sts[decision.first]);
 
-    return bestProfit;
+	numPendingTasks += static_cast<int>(frame.children.size()) - 1;
+	for(size_t i = frame.children.size() - 1; i >= 1; i--) {
+		path.emplace_back(frame.job, frame.children[i].second);
+		worker.tasks.push_back({ path, -frame.children[i].first, frame.nodeIx });
+		path.pop_back();
+	}
+	frame.children.resize(1);
 }
 
-void BranchAndBound::foundLeaf(vector<int> &sts) {
-    sts[p.lastJob] = 0;
-    p.eachJobConst([&](int i) {
-        if(i < p.lastJob)
-            sts[p.lastJob] = Utils::max(sts[i] + p.durations[i], sts[p.lastJob]);
-    });
-    float profit = p.calcProfit(sts);
-    if(profit > lb) {
-        candidate = sts;
-        lb = profit;
-        std::cout << "Updated lower bound = " << lb << std::endl;
-		//if(tr != nullptr) tr->trace(sw.look(), lb);
-    }
+// Depth first search below (job, stj) over (job, start time) decisions, jobs in index order and start times by descending upper bound
+void BranchAndBound::depthFirstSearch(Worker &worker, int parentIx, int job, int stj, float ub) {
+	if(enterNode(worker, parentIx, job, stj, ub))
+		expandStack(worker);
+}
+
+// Continues the depth first search from the frames on the stack until it is empty or a limit is reached
+void BranchAndBound::expandStack(Worker &worker) {
+	while(!worker.stack.empty()) {
+		if(checkpointDue())
+			writeCheckpoint(worker);
+
+		Frame &frame = worker.stack.back();
+
+		if(frame.nextChild < frame.children.size()) {
+			const auto &child = frame.children[frame.nextChild++];
+			if(!enterNode(worker, frame.nodeIx, frame.job, child.second, -child.first)) {
+				// the child was not searched, resuming starts with it
+				worker.stack.back().nextChild--;
+				if(!checkpointFilename.empty())
+					writeCheckpoint(worker);
+				worker.stack.clear();
+				return;
+			}
+			continue;
+		}
+
+		int j = frame.nextJob;
+		while(j < p.numJobs && !isEligible(worker.partial, j)) j++;
+
+		if(j == p.numJobs - 1) {
+			vector<int> sts = worker.partial.sts;
+			foundLeaf(sts);
+			logLeaf(frame.nodeIx, sts);
+			j = p.numJobs;
+		}
+
+		if(j >= p.numJobs) {
+			worker.stack.pop_back();
+			unscheduleLastJob(worker.partial);
+			continue;
+		}
+
+		frame.job = j;
+		frame.nextJob = j + 1;
+		collectChildren(worker.partial, frame.nodeIx, j, frame.children);
+		frame.nextChild = 0;
+		if(threadCount > 1) shareChildren(worker, frame);
+	}
 }
 
-void BranchAndBound::branch(vector<int> sts, int job, int stj) {
-	if ((timeLimit != -1.0 && sw.look() >= timeLimit * 1000.0)
-		|| (iterLimit != -1 && nodeCtr >= iterLimit))
-		return;
+// False if the search has to stop, a node pruned by the transposition table gets no frame
+bool BranchAndBound::enterNode(Worker &worker, int parentIx, int job, int stj, float ub) {
+	const int nodeIx = visitNode(worker, parentIx, job, stj, ub);
+	if(nodeIx > 0)
+		worker.stack.push_back({ nodeIx, 0, -1, {}, 0 });
+	return nodeIx >= 0;
+}
+
+// Schedules job at stj and returns the index of the new node, 0 if propagation or the transposition table prunes it and -1 if the search has to stop
+int BranchAndBound::visitNode(Worker &worker, int parentIx, int job, int stj, float ub) {
+	if(limitReached())
+		return -1;
+
+	scheduleJob(worker.partial, job, stj);
+
+	if(worker.partial.propagator != nullptr && !worker.partial.propagator->isConsistent()) {
+		boundCtr++;
+		unscheduleLastJob(worker.partial);
+		logNode(-1, parentIx, job, stj, ub, NodeLog::Reason::Propagation);
+		return 0;
+	}
+
+	TranspositionTable::Key key = { 0, 0 };
+	if(tt != nullptr) {
+		key = stateKey(worker.partial);
+		if(tt->isDominated(key, bounds.costs(worker.partial.profile), static_cast<int>(worker.partial.trail.size()))) {
+			unscheduleLastJob(worker.partial);
+			logNode(-1, parentIx, job, stj, ub, NodeLog::Reason::Transposition);
+			return 0;
+		}
+	}
+
+	const int nodeIx = ++nodeCtr;
+	if(iterLimit != -1 && nodeIx > iterLimit) {
+		nodeCtr--;
+		aborted = true;
+		// leave the node unvisited, so a resumed search visits it
+		if(tt != nullptr) tt->forget(key);
+		unscheduleLastJob(worker.partial);
+		return -1;
+	}
 
 	if(tr != nullptr) {
 		tr->intervalTrace(lb, 1, 1);
 	}
 
-	sts[job] = stj;
+	logNode(nodeIx, parentIx, job, stj, ub, NodeLog::Reason::Visited);
+	return nodeIx;
+}
 
- 	nodeCtr++;
-	int nodeIx = nodeCtr;
-	addNodeLabelToGraph(nodeIx, sts);
+// Children over all eligible jobs by descending upper bound, true if only the sink is left and the node is a leaf
+bool BranchAndBound::expandNode(PartialSchedule &partial, int nodeIx, vector<Child> &children) {
+	children.clear();
+	bool leaf = true;
+	vector<pair<float, int>> jobChildren;
+	for(int j = 0; j < p.numJobs - 1; j++) {
+		if(!isEligible(partial, j)) continue;
+		leaf = false;
+		collectChildren(partial, nodeIx, j, jobChildren);
+		for(const auto &child : jobChildren)
+			children.push_back({ -child.first, j, child.second });
+	}
+	stable_sort(children.begin(), children.end(), [](const Child &a, const Child &b) { return a.ub > b.ub; });
+	return leaf;
+}
 
-    int maxSt = p.latestStartingTimeInPartial(sts);
+// Expands the open node with the highest upper bound first, so the bound of the popped node is a global upper bound
+void BranchAndBound::bestFirstSearch() {
+	Worker &worker = singleWorker();
+
+	const auto taskBytes = [](const vector<pair<int, int>> &path) { return sizeof(Task) + path.capacity() * sizeof(pair<int, int>); };
+	const auto worse = [](const Task &a, const Task &b) { return a.ub < b.ub || (a.ub == b.ub && a.path.size() < b.path.size()); };
+	priority_queue<Task, vector<Task>, decltype(worse)> open(worse);
+	open.push({ { { 0, 0 } }, upperBound, 0 });
+	size_t openBytes = taskBytes(open.top().path);
+
+	vector<Child> children;
+	while(!open.empty() && !aborted) {
+		Task task = open.top();
+		open.pop();
+		openBytes -= taskBytes(task.path);
+
+		// children never have a higher bound than their parent
+		if(task.ub <= lb) {
+			boundCtr += static_cast<int>(open.size()) + 1;
+			logNode(-1, task.parentIx, task.path.back().first, task.path.back().second, task.ub, NodeLog::Reason::Bound);
+			for(; !open.empty(); open.pop())
+				logNode(-1, open.top().parentIx, open.top().path.back().first, open.top().path.back().second, open.top().ub, NodeLog::Reason::Bound);
+			break;
+		}
+		upperBound = task.ub;
 
-	for(int j = 0; j < p.numJobs; j++) {
-		if(isEligible(sts, j)) {
-			if(j == p.numJobs - 1) {
-                foundLeaf(sts);
-				addLeafToGraph(nodeIx, sts);
-                return;
+		restorePathPrefix(worker.partial, task.path);
+		const int job = task.path.back().first, stj = task.path.back().second;
+
+		if(openBytes >= strategyParams.openNodesBudgetBytes) {
+			depthFirstSearch(worker, task.parentIx, job, stj, task.ub);
+			continue;
+		}
+
+		const int nodeIx = visitNode(worker, task.parentIx, job, stj, task.ub);
+		if(nodeIx < 0) break;
+		if(nodeIx == 0) continue;
+
+		if(expandNode(worker.partial, nodeIx, children)) {
+			vector<int> sts = worker.partial.sts;
+			foundLeaf(sts);
+			logLeaf(nodeIx, sts);
+			continue;
+		}
+
+		for(const Child &child : children) {
+			Task next = { task.path, child.ub, nodeIx };
+			next.path.emplace_back(child.job, child.stj);
+			openBytes += taskBytes(next.path);
+			open.push(move(next));
+		}
+	}
+}
+
+// Keeps the beamWidth nodes of each level with the highest upper bounds
+void BranchAndBound::beamSearch() {
+	Worker &worker = singleWorker();
+
+	vector<Task> beam = { { { { 0, 0 } }, upperBound, 0 } };
+	vector<Task> candidates;
+	vector<Child> children;
+
+	while(!beam.empty() && !aborted) {
+		candidates.clear();
+
+		for(const Task &task : beam) {
+			if(task.ub <= lb) {
+				boundCtr++;
+				logNode(-1, task.parentIx, task.path.back().first, task.path.back().second, task.ub, NodeLog::Reason::Bound);
+				continue;
 			}
-			
-			list<pair<float, int>> ubToT;
-
-			for(int t = p.computeLastPredFinishingTimeForSts(sts, j); true; t++) {
-				pair<bool, bool> feas = resourceFeasibilityCheck(sts, j, t);
-
-				// feasible with possibly maximum amount of overtime
-				if(feas.first) {
-					// fathom redundant schedules
-					/*if (t < maxSt) {
-						boundCtr++;
-						continue;
-					}*/
-					
-					sts[j] = t;
-                    float ub = upperBoundForPartialSimple(sts);
-					sts[j] = Project::UNSCHEDULED;
-
-					// fathom proven suboptimal schedules
-					if(ub > lb) ubToT.push_back(std::make_pair(-ub, t));
-					else boundCtr++;
+
+			restorePathPrefix(worker.partial, task.path);
+			const int nodeIx = visitNode(worker, task.parentIx, task.path.back().first, task.path.back().second, task.ub);
+			if(nodeIx < 0) return;
+			if(nodeIx == 0) continue;
+
+			if(expandNode(worker.partial, nodeIx, children)) {
+				vector<int> sts = worker.partial.sts;
+				foundLeaf(sts);
+				logLeaf(nodeIx, sts);
+				continue;
+			}
+
+			for(const Child &child : children) {
+				candidates.push_back({ task.path, child.ub, nodeIx });
+				candidates.back().path.emplace_back(child.job, child.stj);
+			}
+		}
+
+		const size_t width = Utils::min(candidates.size(), static_cast<size_t>(Utils::max(1, strategyParams.beamWidth)));
+		partial_sort(candidates.begin(), candidates.begin() + width, candidates.end(), [](const Task &a, const Task &b) { return a.ub > b.ub; });
+		beam.clear();
+		for(size_t i = 0; i < width; i++)
+			beam.push_back(move(candidates[i]));
+	}
+}
+
+// Iteration k follows the child order of the bounds and deviates from it by at most k discrepancies along each path
+void BranchAndBound::limitedDiscrepancySearch() {
+	Worker &worker = singleWorker();
+
+	struct DiscrepancyFrame {
+		int nodeIx;
+		vector<Child> children;
+		size_t nextChild;
+		int discrepanciesLeft;
+	};
+	vector<DiscrepancyFrame> stack;
+
+	const auto enter = [&](int parentIx, int job, int stj, float ub, int discrepanciesLeft) {
+		const int nodeIx = visitNode(worker, parentIx, job, stj, ub);
+		if(nodeIx <= 0) return nodeIx == 0;
+		vector<Child> children;
+		if(expandNode(worker.partial, nodeIx, children)) {
+			vector<int> sts = worker.partial.sts;
+			foundLeaf(sts);
+			logLeaf(nodeIx, sts);
+			unscheduleLastJob(worker.partial);
+			return true;
+		}
+		stack.push_back({ nodeIx, move(children), 0, discrepanciesLeft });
+		return true;
+	};
+
+	for(int k = 0; k <= strategyParams.maxDiscrepancies; k++) {
+		if(!enter(0, 0, 0, upperBound, k)) return;
+
+		while(!stack.empty()) {
+			DiscrepancyFrame &frame = stack.back();
+			const int rank = static_cast<int>(frame.nextChild);
+
+			if(frame.nextChild < frame.children.size() && rank <= frame.discrepanciesLeft) {
+				const Child child = frame.children[frame.nextChild++];
+				if(child.ub <= lb) {
+					boundCtr++;
+					logNode(-1, frame.nodeIx, child.job, child.stj, child.ub, NodeLog::Reason::Bound);
+					continue;
 				}
+				if(!enter(frame.nodeIx, child.job, child.stj, child.ub, frame.discrepanciesLeft - rank)) return;
+				continue;
+			}
+
+			stack.pop_back();
+			unscheduleLastJob(worker.partial);
+		}
+	}
+}
+
+namespace {
+	inline uint64_t splitmix64(uint64_t x) {
+		x += 0x9e3779b97f4a7c15ULL;
+		x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+		x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+		return x ^ (x >> 31);
+	}
+
+	struct KeyBuilder {
+		TranspositionTable::Key key = { 0x243f6a8885a308d3ULL, 0x13198a2e03707344ULL };
+		void add(int value) {
+			const uint64_t v = static_cast<uint64_t>(static_cast<uint32_t>(value));
+			key.hash = splitmix64(key.hash ^ v);
+			key.check = splitmix64(key.check + v * 0xff51afd7ed558ccdULL);
+		}
+	};
+}
+
+// Future decisions only depend on the scheduled set, the finish times of scheduled jobs with unscheduled successors
+// and the demand profile after the earliest period an unscheduled job can start in, costs before it are sunk
+TranspositionTable::Key BranchAndBound::stateKey(const PartialSchedule &partial) const {
+	KeyBuilder kb;
+	int decisionPoint = numeric_limits<int>::max(), maxFinish = 0;
+
+	for(int j = 0; j < p.numJobs; j++) {
+		if(partial.sts[j] == Project::UNSCHEDULED) {
+			if(partial.numUnscheduledPreds[j] == 0) {
+				int lastPredFinished = 0;
+				for(int i : p.preds[j])
+					lastPredFinished = Utils::max(lastPredFinished, partial.sts[i] + p.durations[i]);
+				decisionPoint = Utils::min(decisionPoint, lastPredFinished);
+			}
+			continue;
+		}
 
-				// feasible without any overtime
+		kb.add(j);
+		const int finish = partial.sts[j] + p.durations[j];
+		maxFinish = Utils::max(maxFinish, finish);
+		for(int k : p.succs[j]) {
+			if(partial.sts[k] == Project::UNSCHEDULED) {
+				kb.add(finish);
+				break;
+			}
+		}
+		kb.add(-1);
+	}
+
+	if(decisionPoint == numeric_limits<int>::max()) decisionPoint = maxFinish;
+	kb.add(decisionPoint);
+	// monotone start times restrict the completions by the last decision
+	if(rules.startMonotone && !partial.trail.empty()) {
+		kb.add(partial.sts[partial.trail.back().first]);
+		kb.add(topRanks[partial.trail.back().first]);
+	}
+	kb.add(maxFinish);
+	for(int r = 0; r < p.numRes; r++)
+		for(int tau = decisionPoint + 1; tau <= maxFinish; tau++)
+			kb.add(partial.profile.cumulativeDemand(r, tau));
+
+	return kb.key;
+}
+
+void BranchAndBound::collectChildren(PartialSchedule &partial, int nodeIx, int j, vector<pair<float, int>> &children) {
+	children.clear();
+
+	const auto lastPredFinishedOf = [&](int k) {
+		int lastPredFinished = 0;
+		for(int i : p.preds[k])
+			lastPredFinished = Utils::max(lastPredFinished, partial.sts[i] + p.durations[i]);
+		return lastPredFinished;
+	};
+	const int lastPredFinished = lastPredFinishedOf(j);
+
+	// start times outside the propagated window of a job cannot be completed profitably
+	const Propagator *propagator = partial.propagator.get();
+	const auto estOf = [&](int k) { return propagator != nullptr ? Utils::max(lastPredFinishedOf(k), propagator->est(k)) : lastPredFinishedOf(k); };
+	const int lastSt = propagator != nullptr ? propagator->lst(j) : numeric_limits<int>::max();
+	const int makespanLb = propagator != nullptr ? Utils::max(partial.makespanLb, propagator->est(p.lastJob)) : partial.makespanLb;
+
+	// earliest start of the other unscheduled jobs, their eligible ancestors start no earlier
+	int otherEligibleStart = numeric_limits<int>::max();
+	if(!rules.startMonotone)
+		for(int k = 0; k < p.numJobs - 1; k++)
+			if(k != j && isEligible(partial, k))
+				otherEligibleStart = Utils::min(otherEligibleStart, estOf(k));
+
+	const int firstSt = rules.startMonotone && !partial.trail.empty() ? Utils::max(estOf(j), partial.sts[partial.trail.back().first]) : estOf(j);
+
+	for(int t = firstSt; t <= lastSt; t++) {
+		float costsWithJob;
+		pair<bool, bool> feas = resourceFeasibilityCheck(partial, j, t, costsWithJob);
+
+		// feasible with possibly maximum amount of overtime
+		if(feas.first) {
+			// fathom redundant schedules
+			if(violatesStartOrder(partial, j, t)) {
+				dominanceCtr++;
+				logNode(-1, nodeIx, j, t, numeric_limits<float>::max(), NodeLog::Reason::Dominance);
+				continue;
+			}
+			if(isLeftShiftable(partial, j, t, lastPredFinished)) {
+				dominanceCtr++;
+				logNode(-1, nodeIx, j, t, numeric_limits<float>::max(), NodeLog::Reason::Dominance);
 				if(feas.second) break;
+				continue;
 			}
 
-			ubToT.sort();
-			for(auto p : ubToT) {
-				addArrowToGraph(nodeIx, nodeCtr + 1);
-				branch(sts, j, p.second);
+			const int msMin = Utils::max(makespanLb, t + tails[j]);
+
+			// fathom proven suboptimal schedules, the cheap bound ignoring the missing work first
+			if(p.revenue[msMin] - costsWithJob <= lb) {
+				boundCtr++;
+				logNode(-1, nodeIx, j, t, p.revenue[msMin] - costsWithJob, NodeLog::Reason::Bound);
+			} else {
+				bounds.fixJob(partial.profile, j, t);
+				const int earliestStart = rules.startMonotone ? t : Utils::min(otherEligibleStart, t + p.durations[j]);
+				const float ub = bounds.partialProfitUpperBound(partial.profile, msMin, earliestStart);
+				bounds.releaseJob(partial.profile, j, t);
+
+				if(ub > lb) children.emplace_back(-ub, t);
+				else {
+					boundCtr++;
+					logNode(-1, nodeIx, j, t, ub, NodeLog::Reason::Bound);
+				}
 			}
 		}
+
+		// feasible without any overtime
+		if(feas.second) break;
 	}
+
+	sort(children.begin(), children.end());
 }
 
-void BranchAndBound::addArrowToGraph(int nodeA, int nodeB) {
-    if (!writeGraph) return;
-    dotGraph += to_string(nodeA) + "->" + to_string(nodeB) + "\n";
+// Each schedule is generated once, by the order of its (start time, topological rank) pairs
+bool BranchAndBound::violatesStartOrder(const PartialSchedule &partial, int j, int stj) const {
+	if(!rules.startMonotone || partial.trail.empty()) return false;
+	const int last = partial.trail.back().first, lastSt = partial.sts[last];
+	return stj < lastSt || (stj == lastSt && topRanks[j] < topRanks[last]);
 }
 
-void BranchAndBound::addLeafToGraph(int node, const vector<int> &sts) {
-    if (!writeGraph) return;
-    string stsStr;
-    for(int i = 0; i < sts.size(); i++)
-        stsStr += to_string(sts[i]) + (i + 1 < sts.size() ? "," : "");
-    leafsStr += (to_string(node) + "[label=\"" + stsStr + "\"]\n");
+// With monotone start times no later job occupies periods up to stj, so moving the job to an earlier start
+// that adds no overtime in the periods it newly occupies is at least as profitable for every completion
+bool BranchAndBound::isLeftShiftable(const PartialSchedule &partial, int j, int stj, int lastPredFinished) const {
+	if(!rules.startMonotone || (!rules.localLeftShift && !rules.globalLeftShift)) return false;
+
+	const auto fitsWithoutOvertime = [&](int firstPeriod, int lastPeriod) {
+		for(int r = 0; r < p.numRes; r++)
+			for(int tau = firstPeriod; tau <= lastPeriod; tau++)
+				if(partial.profile.cumulativeDemand(r, tau) + p.demands(j, r) > p.capacities[r])
+					return false;
+		return true;
+	};
+
+	const int earliestShifted = rules.globalLeftShift ? lastPredFinished : Utils::max(lastPredFinished, stj - 1);
+	for(int shiftedSt = stj - 1; shiftedSt >= earliestShifted; shiftedSt--)
+		if(fitsWithoutOvertime(shiftedSt + 1, Utils::min(stj, shiftedSt + p.durations[j])))
+			return true;
+
+	return false;
 }
 
-void BranchAndBound::addNodeLabelToGraph(int node, const vector<int>& sts) {
-    if (!writeGraph) return;
-    string stsStr;
-    for (int i = 0; i < sts.size(); i++)
-        stsStr += ((sts[i] == Project::UNSCHEDULED) ? "_" : to_string(sts[i])) + (i + 1 < sts.size() ? "," : "") + ((i+1) % 4 == 0 ? "\n" : "");
-    leafsStr += (to_string(node) + "[label=\"#" + to_string(node) + "\n" + stsStr + "\"]\n");
+void BranchAndBound::logNode(int nodeIx, int parentIx, int job, int stj, float bound, NodeLog::Reason reason) {
+	if(nodeLog == nullptr) return;
+	nodeLog->append({ nodeIx, parentIx, job, stj, bound, reason });
 }
 
-void BranchAndBound::drawGraph() {
-    if(!writeGraph) return;
-    
-    dotGraph += leafsStr;
-    dotGraph += "\n}";
-    
-    const string dotFilename = "bbgraph.dot";
-    Utils::spit(dotGraph, dotFilename);
-    system(("dot -Tpdf " + dotFilename + " -o" + dotFilename + ".pdf").c_str());
+// The leaf record carries the makespan as start and the profit as bound
+void BranchAndBound::logLeaf(int nodeIx, const vector<int> &sts) {
+	if(nodeLog == nullptr) return;
+	nodeLog->append({ nodeIx, nodeIx, p.lastJob, sts[p.lastJob], p.calcProfit(sts), NodeLog::Reason::Leaf });
 }
 
-void BranchAndBound::graphPreamble() {
-    if(!writeGraph) return;
-    dotGraph = "digraph precedence{\n";
+bool BranchAndBound::checkpointDue() {
+	return !checkpointFilename.empty() && sw.look() - lastCheckpointTime >= checkpointInterval * 1000.0;
+}
+
+// The stack holds one frame per decision on the path to the current node
+void BranchAndBound::writeCheckpoint(const Worker &worker) {
+	Checkpoint::Writer writer(checkpointFilename, CHECKPOINT_VERSION);
+	writer.putString(p.instanceName);
+	writer.put(p.numJobs);
+	writer.put(rules);
+	writer.put(propagation);
+	writer.put(edgeFinding);
+
+	writer.put(lb.load());
+	writer.putVector(candidate);
+	writer.put(nodeCtr.load());
+	writer.put(boundCtr.load());
+	writer.put(dominanceCtr.load());
+	writer.put(upperBound);
+	writer.put(deadline);
+
+	writer.put<uint64_t>(worker.stack.size());
+	for(const auto &decision : worker.partial.trail) {
+		writer.put(decision.first);
+		writer.put(worker.partial.sts[decision.first]);
+	}
+	for(const Frame &frame : worker.stack) {
+		writer.put(frame.nodeIx);
+		writer.put(frame.nextJob);
+		writer.put(frame.job);
+		writer.put<uint64_t>(frame.nextChild);
+		writer.put<uint64_t>(frame.children.size());
+		for(const auto &child : frame.children) {
+			writer.put(child.first);
+			writer.put(child.second);
+		}
+	}
+
+	writer.put(tt != nullptr);
+	if(tt != nullptr)
+		tt->save(writer);
+
+	writer.commit();
+	lastCheckpointTime = sw.look();
+}
+
+void BranchAndBound::readCheckpoint() {
+	Checkpoint::Reader reader(checkpointFilename, CHECKPOINT_VERSION);
+	const string instanceName = reader.getString();
+	const int numJobs = reader.get<int>();
+	if(instanceName != p.instanceName || numJobs != p.numJobs)
+		throw runtime_error("Checkpoint " + checkpointFilename + " belongs to instance " + instanceName + "!");
+
+	const DominanceRules savedRules = reader.get<DominanceRules>();
+	const bool savedPropagation = reader.get<bool>(), savedEdgeFinding = reader.get<bool>();
+	if(savedRules.startMonotone != rules.startMonotone || savedRules.localLeftShift != rules.localLeftShift || savedRules.globalLeftShift != rules.globalLeftShift
+	   || savedPropagation != propagation || savedEdgeFinding != edgeFinding)
+		throw runtime_error("Checkpoint " + checkpointFilename + " was written with other pruning rules!");
+
+	lb = reader.get<float>();
+	candidate = reader.getVector<int>();
+	nodeCtr = reader.get<int>();
+	boundCtr = reader.get<int>();
+	dominanceCtr = reader.get<int>();
+	upperBound = reader.get<float>();
+	deadline = reader.get<int>();
+
+	Worker &worker = singleWorker();
+	const uint64_t depth = reader.get<uint64_t>();
+	for(uint64_t k = 0; k < depth; k++) {
+		const int j = reader.get<int>(), stj = reader.get<int>();
+		scheduleJob(worker.partial, j, stj);
+	}
+	for(uint64_t k = 0; k < depth; k++) {
+		Frame frame;
+		frame.nodeIx = reader.get<int>();
+		frame.nextJob = reader.get<int>();
+		frame.job = reader.get<int>();
+		frame.nextChild = static_cast<size_t>(reader.get<uint64_t>());
+		frame.children.resize(static_cast<size_t>(reader.get<uint64_t>()));
+		for(auto &child : frame.children) {
+			child.first = reader.get<float>();
+			child.second = reader.get<int>();
+		}
+		worker.stack.push_back(move(frame));
+	}
+
+	// a search without transposition table ignores the saved one
+	if(reader.get<bool>() && tt != nullptr)
+		tt->load(reader);
 }
 
 void BranchAndBound::solvePath(const string &path) {
@@ -298,6 +897,41 @@ void BranchAndBound::solvePath(const string &path) {
     outFile.close();
 }
 
+BranchAndBound::StrategyParameters BranchAndBound::strategyFromSuffix(const string &suffix, int &threadCount) {
+	StrategyParameters params;
+	threadCount = 1;
+
+	const auto numberAfter = [&suffix](const string &prefix, int defaultValue) {
+		return suffix.length() > prefix.length() ? stoi(suffix.substr(prefix.length())) : defaultValue;
+	};
+
+	if(suffix.empty()) return params;
+
+	if(suffix == "BestFirst") {
+		params.type = Strategy::BestFirst;
+	} else if(boost::starts_with(suffix, "Beam")) {
+		params.type = Strategy::Beam;
+		params.beamWidth = numberAfter("Beam", params.beamWidth);
+	} else if(boost::starts_with(suffix, "LDS")) {
+		params.type = Strategy::LimitedDiscrepancy;
+		params.maxDiscrepancies = numberAfter("LDS", params.maxDiscrepancies);
+	} else if(all_of(suffix.begin(), suffix.end(), [](char c) { return isdigit(c) != 0; })) {
+		threadCount = stoi(suffix);
+	} else {
+		throw runtime_error("Unknown branch and bound strategy: " + suffix + "!");
+	}
+
+	return params;
+}
+
 string BranchAndBound::getTraceFilename(const string& outPath, const string& instanceName) {
 	return outPath + "BranchAndBoundTrace_" + instanceName;
 }
+
+string BranchAndBound::getNodeLogFilename(const string& outPath, const string& instanceName) {
+	return outPath + "BranchAndBoundNodes_" + instanceName + ".bin";
+}
+
+string BranchAndBound::getCheckpointFilename(const string& outPath, const string& instanceName) {
+	return outPath + "BranchAndBoundCheckpoint_" + instanceName + ".bin";
+}
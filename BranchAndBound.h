@@ -2,56 +2,189 @@
 
 #include <vector>
 #include <string>
+#include <atomic>
+#include <deque>
+#include <mutex>
 
 #include "Matrix.h"
 #include "Stopwatch.h"
 #include "Utils.h"
+#include "Logger.h"
+#include "TranspositionTable.h"
+#include "Bounds.h"
+#include "Propagator.h"
+#include "NodeLog.h"
 
 class ProjectWithOvertime;
 class Stopwatch;
 
-namespace Utils {
-	class Tracer;
-}
-
 class BranchAndBound {
 public:
-	explicit BranchAndBound(ProjectWithOvertime& _p, double _timeLimit = 60.0, int _iterLimit = -1, bool _writeGraph = false);
+	// Schedules are only generated in order of non-decreasing start times with ties broken by topological rank.
+	// The left-shift rules rely on this order and are ignored without startMonotone.
+	struct DominanceRules {
+		bool startMonotone = true;
+		// Skip start time t if the job could start at t-1 without additional overtime
+		bool localLeftShift = true;
+		// Skip start time t if the job could start at any earlier time without additional overtime
+		bool globalLeftShift = true;
+	};
+
+	enum class Strategy { DepthFirst, BestFirst, Beam, LimitedDiscrepancy };
+
+	// Depth-first and best-first search are exact, beam and limited discrepancy search are heuristics.
+	// Only depth-first search uses more than one thread.
+	struct StrategyParameters {
+		Strategy type = Strategy::DepthFirst;
+		// Best-first keeps open nodes within this budget, nodes popped while it is exhausted are solved depth-first
+		size_t openNodesBudgetBytes = 256 * 1024 * 1024;
+		// Nodes kept per level by beam search
+		int beamWidth = 64;
+		// Iterations of limited discrepancy search, taking the i-th best child of a node costs i discrepancies
+		int maxDiscrepancies = 4;
+	};
+
+	// threadCount > 1 distributes subtrees over workers with work-stealing, writeNodeLog streams all nodes to the file of getNodeLogFilename
+	explicit BranchAndBound(ProjectWithOvertime& _p, double _timeLimit = 60.0, int _iterLimit = -1, bool _writeNodeLog = false, int _threadCount = 1);
     ~BranchAndBound();
 	std::vector<int> solve(bool seedWithGA = false, bool traceobj = false, const std::string &outPath = "");
 
     static void solvePath(const std::string &path);
 
 	static std::string getTraceFilename(const std::string& outPath, const std::string& instanceName);
+	static std::string getNodeLogFilename(const std::string& outPath, const std::string& instanceName);
+	static std::string getCheckpointFilename(const std::string& outPath, const std::string& instanceName);
+	// Suffix of the solution method after "BranchAndBound": empty, thread count N, BestFirst, Beam[Width] or LDS[MaxDiscrepancies]
+	static StrategyParameters strategyFromSuffix(const std::string &suffix, int &threadCount);
+
+	int getNodeCount() const { return nodeCtr; }
+	int getBoundCount() const { return boundCtr; }
+	int getDominanceCount() const { return dominanceCtr; }
+	void setDominanceRules(const DominanceRules &_rules) { rules = _rules; }
+	void setStrategy(const StrategyParameters &_strategyParams) { strategyParams = _strategyParams; }
+	// Prunes nodes whose start time windows become empty for the latest makespan that can beat the initial lower bound
+	// and restricts the start times of children to their windows
+	void setPropagation(bool _propagation, bool _edgeFinding = false) { propagation = _propagation; edgeFinding = _edgeFinding; }
+	// Subgradient iterations of the Lagrangian relaxation tightening the root upper bound, 0 disables it
+	void setLagrangianIterations(int _lagrangianIterations) { lagrangianIterations = _lagrangianIterations; }
+	// Proven upper bound on the optimal profit, equals the incumbent after a completed exact search
+	float getUpperBound() const { return upperBound; }
+	// Budget of the table pruning states reached again with equal or higher costs, 0 disables it
+	void setTranspositionTableBudget(size_t bytes) { ttBudgetBytes = bytes; }
+	TranspositionTable::Statistics getTranspositionStatistics() const;
+	// Writes the frontier of the depth-first search, the incumbent, the counters and the transposition table to filename
+	// every intervalSecs seconds and when a limit stops the search. solve resumes from an existing checkpoint and removes it
+	// once the search is complete. The schedule limit counts the nodes of all runs, the time limit applies to each run.
+	// Only the sequential depth-first search supports checkpoints.
+	void setCheckpoint(const std::string &_checkpointFilename, double _checkpointIntervalSecs = 600.0) { checkpointFilename = _checkpointFilename; checkpointInterval = _checkpointIntervalSecs; }
+	// Empty unless solve was called with traceobj
+	std::vector<Utils::Tracer::TracePoint> anytimeCurve() const;
 
 private:
 	Stopwatch sw;
 	ProjectWithOvertime &p;
-	float lb;
+	Bounds bounds;
+	std::atomic<float> lb;
 	std::vector<int> candidate;
-	int nodeCtr, boundCtr;
-	std::string dotGraph, leafsStr;
-	bool writeGraph;
+	std::mutex candidateMutex;
+	std::atomic<int> nodeCtr, boundCtr, dominanceCtr;
+	DominanceRules rules;
+	StrategyParameters strategyParams;
+	float upperBound;
+	bool writeNodeLog, propagation, edgeFinding, resumed;
+	int deadline, lagrangianIterations;
     //TimePoint lupdate;
 	double timeLimit;
-	int iterLimit;
+	int iterLimit, threadCount;
 	std::unique_ptr<Utils::Tracer> tr;
-	
-	bool isEligible(const std::vector<int> &sts, int j) const;
-	std::pair<bool,bool> resourceFeasibilityCheck(std::vector<int> &sts, int j, int stj) const;
-	void branch(std::vector<int> sts, int job, int stj);
+	size_t ttBudgetBytes;
+	std::unique_ptr<TranspositionTable> tt;
+	std::unique_ptr<NodeLog> nodeLog;
+	std::string checkpointFilename;
+	double checkpointInterval, lastCheckpointTime;
+
+	// Partial schedule of the current node, updated when branching and restored when backtracking
+	struct PartialSchedule {
+		std::vector<int> sts, numUnscheduledPreds;
+		Bounds::Profile profile;
+		// Makespan of the earliest start completion, i.e. max of sts[i] + tails[i] over scheduled jobs
+		int makespanLb;
+		// Scheduled job and makespanLb before it was scheduled
+		std::vector<std::pair<int, int>> trail;
+		// Start time windows of the unscheduled jobs, only with propagation
+		std::unique_ptr<Propagator> propagator;
+	};
+	// Longest path from start of job to start of the sink
+	const std::vector<int> &tails;
+	// Position of job in the topological order
+	std::vector<int> topRanks;
+
+	struct Frame {
+		int nodeIx, nextJob, job;
+		// Pairs of negated upper bound and start time for job, ascending
+		std::vector<std::pair<float, int>> children;
+		size_t nextChild;
+	};
+
+	// Child of a node over all eligible jobs
+	struct Child {
+		float ub;
+		int job, stj;
+	};
+
+	// Subtree below the node reached by scheduling the (job, start time) pairs of path in order
+	struct Task {
+		std::vector<std::pair<int, int>> path;
+		float ub;
+		// Node index of the parent for the node log
+		int parentIx = 0;
+	};
+
+	// Search state of one thread, the sequential search uses a single worker
+	struct Worker {
+		PartialSchedule partial;
+		std::vector<Frame> stack;
+		// Owner pops from the back, thieves steal from the front which holds the larger subtrees
+		std::deque<Task> tasks;
+		std::mutex tasksMutex;
+	};
+	std::vector<std::unique_ptr<Worker>> workers;
+	std::atomic<int> numPendingTasks, numIdleWorkers;
+	std::atomic<bool> aborted;
+
+	void initPartialSchedule(PartialSchedule &partial) const;
+	void scheduleJob(PartialSchedule &partial, int j, int stj) const;
+	void unscheduleLastJob(PartialSchedule &partial) const;
+	void initJobAttributes();
+	void restorePathPrefix(PartialSchedule &partial, const std::vector<std::pair<int, int>> &path) const;
+	bool isEligible(const PartialSchedule &partial, int j) const;
+	std::pair<bool,bool> resourceFeasibilityCheck(const PartialSchedule &partial, int j, int stj, float &costsWithJob) const;
+	bool limitReached();
+	Worker &singleWorker();
+	float rootUpperBound();
+	void search();
+	void bestFirstSearch();
+	void beamSearch();
+	void limitedDiscrepancySearch();
+	bool expandNode(PartialSchedule &partial, int nodeIx, std::vector<Child> &children);
+	void parallelSearch();
+	void runWorker(int workerIx);
+	bool popTask(int workerIx, Task &task);
+	void shareChildren(Worker &worker, Frame &frame);
+	void depthFirstSearch(Worker &worker, int parentIx, int job, int stj, float ub);
+	void expandStack(Worker &worker);
+	bool enterNode(Worker &worker, int parentIx, int job, int stj, float ub);
+	int visitNode(Worker &worker, int parentIx, int job, int stj, float ub);
+	TranspositionTable::Key stateKey(const PartialSchedule &partial) const;
+	void collectChildren(PartialSchedule &partial, int nodeIx, int j, std::vector<std::pair<float, int>> &children);
+	bool violatesStartOrder(const PartialSchedule &partial, int j, int stj) const;
+	bool isLeftShiftable(const PartialSchedule &partial, int j, int stj, int lastPredFinished) const;
     void foundLeaf(std::vector<int> &sts);
-    
-    float upperBoundForPartial(const std::vector<int> &sts) const;
-    float upperBoundForPartial2(const std::vector<int> &sts) const;
-    float upperBoundForPartialSimple(const std::vector<int> &sts) const;
-    struct AreaData;
-    AreaData computeAreas(const std::vector<int> &sts, const Matrix<int> &resRem, int tmin, int tmax) const;
-    float costsLbForMakespan(int msMin, const std::vector<int> &missingDemand, const std::vector<int> &freeArea, std::vector<int> &overtime, int ms) const;
-
-	void addArrowToGraph(int nodeA, int nodeB);
-	void addLeafToGraph(int node, const std::vector<int> &sts);
-	void addNodeLabelToGraph(int node, const std::vector<int> &sts);
-	void drawGraph();
-	void graphPreamble();
+
+	void logNode(int nodeIx, int parentIx, int job, int stj, float bound, NodeLog::Reason reason);
+	void logLeaf(int nodeIx, const std::vector<int> &sts);
+
+	bool checkpointDue();
+	void writeCheckpoint(const Worker &worker);
+	void readCheckpoint();
 };
@@ -0,0 +1,376 @@
+// Microbenchmarks for the schedule generation schemes, decoders and genetic operators.
+// Run from the repository root so the bundled instances in Data/ are found, e.g.
+//   ./CPP-RCPSP-OC-Bench --benchmark_filter=Decoder
+// Every benchmark is parameterized over instanceNames() by index, except the BM_Scaling_ ones which take the job count
+// of a generated instance, e.g. --benchmark_filter=Scaling
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <memory>
+
+#include "../InstanceGenerator.h"
+#include "../ProjectWithOvertime.h"
+#include "../Runners.h"
+#include "../ScopedTempWorkingDirectory.h"
+#include "../GeneticAlgorithms/Representations.h"
+#include "../GeneticAlgorithms/Sampling.h"
+
+using namespace std;
+
+namespace {
+	const int NUM_SAMPLES = 64, PARTITION_SIZE = 4, DISCRETIZATION_UB = 4;
+	const vector<string> bundledInstances = { "j3025_4", "PaperBeispiel" };
+	const vector<int> generatedJobCounts = { 120, 300 }, scalingJobCounts = { 30, 120, 300, 600, 1000, 2000 };
+
+	string generatedInstanceContents(int numRealJobs, int seed) {
+		InstanceGenerator::GeneratorParameters params;
+		params.numJobs = numRealJobs;
+		params.seed = seed;
+		return InstanceGenerator::generateSmContents(params);
+	}
+
+	// Projects and random genotypes are built once per instance and shared by all benchmarks
+	struct BenchInstance {
+		unique_ptr<ProjectWithOvertime> p;
+		vector<vector<int>> orders, zrs, betas, partitionLists;
+		vector<vector<float>> taus, discreteTaus, randomKeys;
+		vector<Matrix<int>> zrts;
+		vector<int> deadlineOffsets;
+		int zrtPeriods;
+
+		explicit BenchInstance(unique_ptr<ProjectWithOvertime> _p) : p(move(_p)), zrtPeriods(p->heuristicMakespanUpperBound()) {
+			Utils::seedRandomEngine(42);
+			const int deadlineOffsetUB = p->makespan(p->serialSGS(p->topOrder)) - p->makespan(p->serialSGS(p->topOrder, p->zmax).sts);
+			for(int s = 0; s < NUM_SAMPLES; s++) {
+				orders.push_back(Sampling::sample(true, *p));
+				zrs.push_back(Utils::constructVector<int>(p->numRes, [&](int r) { return Utils::randRangeIncl(0, p->zmax[r]); }));
+				betas.push_back(Utils::constructVector<int>(p->numJobs, [](int j) { return Utils::randRangeIncl(0, 1); }));
+				taus.push_back(Sampling::randomUnitFloats(p->numJobs));
+				discreteTaus.push_back(Utils::constructVector<float>(p->numJobs, [](int j) {
+					return static_cast<float>(Utils::randRangeIncl(0, DISCRETIZATION_UB - 1)) / static_cast<float>(DISCRETIZATION_UB - 1);
+				}));
+				randomKeys.push_back(p->activityListToRandomKey(orders.back()));
+				Matrix<int> zrt(p->numRes, zrtPeriods);
+				p->eachResConst([&](int r) {
+					const int zr = Utils::randRangeIncl(0, p->zmax[r]);
+					for(int t = 0; t < zrtPeriods; t++) zrt(r, t) = zr;
+				});
+				zrts.push_back(zrt);
+				deadlineOffsets.push_back(Utils::randRangeIncl(0, max(0, deadlineOffsetUB)));
+				partitionLists.push_back(p->orderInducedPartitionsToPartitionList(orders.back(), PARTITION_SIZE));
+			}
+		}
+	};
+
+	vector<string> &instanceNames() {
+		static vector<string> names;
+		if(names.empty()) {
+			names = bundledInstances;
+			for(int numJobs : generatedJobCounts)
+				names.push_back("generated" + to_string(numJobs));
+		}
+		return names;
+	}
+
+	BenchInstance &instance(int ix) {
+		static vector<unique_ptr<BenchInstance>> instances(instanceNames().size());
+		if(!instances[ix]) {
+			const string &name = instanceNames()[ix];
+			auto p = ix < static_cast<int>(bundledInstances.size())
+				? make_unique<ProjectWithOvertime>("Data/" + name + ".sm")
+				: make_unique<ProjectWithOvertime>(name, generatedInstanceContents(generatedJobCounts[ix - bundledInstances.size()], ix));
+			instances[ix] = make_unique<BenchInstance>(move(p));
+		}
+		return *instances[ix];
+	}
+
+	// Runs body(instance, sampleIx) per iteration, body returns the number of generated schedules
+	template<class Func>
+	void measureOn(benchmark::State &state, BenchInstance &inst, Func body) {
+		Utils::seedRandomEngine(23);
+
+		int64_t numSchedules = 0, sampleIx = 0;
+		const auto start = chrono::steady_clock::now();
+		for(auto _ : state) {
+			numSchedules += body(inst, static_cast<int>(sampleIx));
+			sampleIx = (sampleIx + 1) % NUM_SAMPLES;
+		}
+		const double elapsedNs = static_cast<double>(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count());
+
+		state.counters["schedules/s"] = benchmark::Counter(static_cast<double>(numSchedules), benchmark::Counter::kIsRate);
+		state.counters["ns/job"] = elapsedNs / static_cast<double>(max<int64_t>(1, state.iterations()) * inst.p->numJobs);
+	}
+
+	template<class Func>
+	void measure(benchmark::State &state, Func body) {
+		state.SetLabel(instanceNames()[state.range(0)]);
+		measureOn(state, instance(static_cast<int>(state.range(0))), body);
+	}
+
+	// Generated instances for the scaling benchmarks keyed by number of real jobs, seed is the job count
+	const string &scalingInstanceContents(int numRealJobs) {
+		static map<int, string> contents;
+		if(!contents.count(numRealJobs))
+			contents[numRealJobs] = generatedInstanceContents(numRealJobs, numRealJobs);
+		return contents[numRealJobs];
+	}
+
+	BenchInstance &scalingInstance(int numRealJobs) {
+		static map<int, unique_ptr<BenchInstance>> instances;
+		auto &inst = instances[numRealJobs];
+		if(!inst)
+			inst = make_unique<BenchInstance>(make_unique<ProjectWithOvertime>("scaling" + to_string(numRealJobs), scalingInstanceContents(numRealJobs)));
+		return *inst;
+	}
+
+	void registerForScalingJobCounts(benchmark::internal::Benchmark *b) {
+		for(int numJobs : scalingJobCounts)
+			b->Arg(numJobs);
+	}
+
+	void registerForAllInstances(benchmark::internal::Benchmark *b) {
+		b->DenseRange(0, static_cast<int>(instanceNames().size()) - 1);
+	}
+}
+
+//======================================================================================================================
+// Schedule generation schemes
+
+static void BM_SerialSGS(benchmark::State &state) {
+	measure(state, [](BenchInstance &inst, int s) {
+		benchmark::DoNotOptimize(inst.p->serialSGS(inst.orders[s]));
+		return 1;
+	});
+}
+BENCHMARK(BM_SerialSGS)->Apply(registerForAllInstances);
+
+static void BM_ParallelSGS(benchmark::State &state) {
+	measure(state, [](BenchInstance &inst, int s) {
+		benchmark::DoNotOptimize(inst.p->parallelSGS(inst.orders[s]));
+		return 1;
+	});
+}
+BENCHMARK(BM_ParallelSGS)->Apply(registerForAllInstances);
+
+static void BM_SerialSGSWithRandomKey(benchmark::State &state) {
+	measure(state, [](BenchInstance &inst, int s) {
+		benchmark::DoNotOptimize(inst.p->serialSGSWithRandomKey(inst.randomKeys[s]));
+		return 1;
+	});
+}
+BENCHMARK(BM_SerialSGSWithRandomKey)->Apply(registerForAllInstances);
+
+static void BM_ForwardBackwardIterations(benchmark::State &state) {
+	measure(state, [](BenchInstance &inst, int s) {
+		const SGSResult res = inst.p->serialSGS(inst.orders[s], inst.zrs[s]);
+		const SGSResult improved = inst.p->forwardBackwardIterations(inst.orders[s], res, inst.p->makespan(res));
+		benchmark::DoNotOptimize(improved.sts.data());
+		return improved.numSchedulesGenerated;
+	});
+}
+BENCHMARK(BM_ForwardBackwardIterations)->Apply(registerForAllInstances);
+
+//======================================================================================================================
+// Decoders of the genetic algorithms in Runners::funcs, named after their representation
+
+#define DECODER_BENCHMARK(name, expr) \
+	static void BM_Decoder_##name(benchmark::State &state) { \
+		measure(state, [](BenchInstance &inst, int s) { \
+			const ProjectWithOvertime &p = *inst.p; \
+			const SGSResult res = expr; \
+			benchmark::DoNotOptimize(res.sts.data()); \
+			return res.numSchedulesGenerated; \
+		}); \
+	} \
+	BENCHMARK(BM_Decoder_##name)->Apply(registerForAllInstances);
+
+DECODER_BENCHMARK(LambdaBeta, p.serialSGSTimeWindowBordersWithForwardBackwardImprovement(inst.orders[s], inst.betas[s], ProjectWithOvertime::BorderSchedulingOptions()))
+DECODER_BENCHMARK(LambdaTau, p.serialSGSTimeWindowArbitraryWithForwardBackwardImprovement(inst.orders[s], inst.taus[s]))
+DECODER_BENCHMARK(LambdaTauDiscrete, p.serialSGSTimeWindowArbitraryWithForwardBackwardImprovement(inst.orders[s], inst.discreteTaus[s]))
+DECODER_BENCHMARK(LambdaZr, p.serialSGSWithForwardBackwardImprovement(inst.orders[s], inst.zrs[s]))
+DECODER_BENCHMARK(LambdaZrt, p.serialSGSWithForwardBackwardImprovement(inst.orders[s], inst.zrts[s]))
+DECODER_BENCHMARK(LambdaAlts, p.serialSGSWithOvertimeWithForwardBackwardImprovement(inst.orders[s]))
+DECODER_BENCHMARK(LambdaGoldenSection, p.goldenSectionSearchBasedOptimization(inst.orders[s]))
+DECODER_BENCHMARK(LambdaDeadlineOffset, p.forwardBackwardDeadlineOffsetSGS(inst.orders[s], inst.deadlineOffsets[s]))
+DECODER_BENCHMARK(RandomKeyZr, p.serialSGSWithRandomKeyAndFBI(inst.randomKeys[s], inst.zrs[s]))
+DECODER_BENCHMARK(RandomKeyZrt, p.serialSGSWithRandomKeyAndFBI(inst.randomKeys[s], inst.zrts[s]))
+DECODER_BENCHMARK(LambdaSub, p.serialOptimalSubSGSAndFBI(inst.orders[s], PARTITION_SIZE))
+DECODER_BENCHMARK(PartitionList, p.serialOptimalSubSGSWithPartitionListAndFBI(inst.partitionLists[s]))
+
+//======================================================================================================================
+// Sampling
+
+static void BM_SamplingRBBRS(benchmark::State &state) {
+	measure(state, [](BenchInstance &inst, int s) {
+		benchmark::DoNotOptimize(Sampling::sample(true, *inst.p));
+		return 0;
+	});
+}
+BENCHMARK(BM_SamplingRBBRS)->Apply(registerForAllInstances);
+
+static void BM_SamplingNaive(benchmark::State &state) {
+	measure(state, [](BenchInstance &inst, int s) {
+		benchmark::DoNotOptimize(Sampling::naiveSampling(*inst.p));
+		return 0;
+	});
+}
+BENCHMARK(BM_SamplingNaive)->Apply(registerForAllInstances);
+
+//======================================================================================================================
+// Crossover and mutation operators
+
+static void BM_LambdaOnePointCrossover(benchmark::State &state) {
+	Lambda daughter;
+	measure(state, [&daughter](BenchInstance &inst, int s) {
+		daughter.order.resize(static_cast<size_t>(inst.p->numJobs));
+		daughter.randomOnePointCrossover(Lambda(inst.orders[s]), Lambda(inst.orders[(s + 1) % NUM_SAMPLES]));
+		benchmark::DoNotOptimize(daughter.order.data());
+		return 0;
+	});
+}
+BENCHMARK(BM_LambdaOnePointCrossover)->Apply(registerForAllInstances);
+
+static void BM_LambdaTwoPointCrossover(benchmark::State &state) {
+	Lambda daughter;
+	measure(state, [&daughter](BenchInstance &inst, int s) {
+		daughter.order.resize(static_cast<size_t>(inst.p->numJobs));
+		daughter.randomTwoPointCrossover(Lambda(inst.orders[s]), Lambda(inst.orders[(s + 1) % NUM_SAMPLES]));
+		benchmark::DoNotOptimize(daughter.order.data());
+		return 0;
+	});
+}
+BENCHMARK(BM_LambdaTwoPointCrossover)->Apply(registerForAllInstances);
+
+static void BM_LambdaZrCrossover(benchmark::State &state) {
+	LambdaZr daughter;
+	measure(state, [&daughter](BenchInstance &inst, int s) {
+		const int f = (s + 1) % NUM_SAMPLES;
+		daughter.order.resize(static_cast<size_t>(inst.p->numJobs));
+		daughter.z.resize(static_cast<size_t>(inst.p->numRes));
+		daughter.randomIndependentOnePointCrossovers(LambdaZr(inst.orders[s], inst.zrs[s]), LambdaZr(inst.orders[f], inst.zrs[f]));
+		benchmark::DoNotOptimize(daughter.order.data());
+		return 0;
+	});
+}
+BENCHMARK(BM_LambdaZrCrossover)->Apply(registerForAllInstances);
+
+static void BM_LambdaZrtCrossover(benchmark::State &state) {
+	measure(state, [](BenchInstance &inst, int s) {
+		const int f = (s + 1) % NUM_SAMPLES;
+		LambdaZrt daughter(inst.p->numJobs, inst.p->numRes, inst.zrtPeriods);
+		daughter.randomIndependentOnePointCrossovers(LambdaZrt(inst.orders[s], inst.zrts[s]), LambdaZrt(inst.orders[f], inst.zrts[f]), inst.zrtPeriods);
+		benchmark::DoNotOptimize(daughter.order.data());
+		return 0;
+	});
+}
+BENCHMARK(BM_LambdaZrtCrossover)->Apply(registerForAllInstances);
+
+static void BM_RandomKeyCrossover(benchmark::State &state) {
+	RandomKey daughter;
+	measure(state, [&daughter](BenchInstance &inst, int s) {
+		daughter.priorities.resize(static_cast<size_t>(inst.p->numJobs));
+		daughter.randomOnePointCrossover(RandomKey(inst.randomKeys[s]), RandomKey(inst.randomKeys[(s + 1) % NUM_SAMPLES]));
+		benchmark::DoNotOptimize(daughter.priorities.data());
+		return 0;
+	});
+}
+BENCHMARK(BM_RandomKeyCrossover)->Apply(registerForAllInstances);
+
+static void BM_PartitionListCombine(benchmark::State &state) {
+	measure(state, [](BenchInstance &inst, int s) {
+		PartitionList mother, father, daughter(inst.p->numJobs);
+		mother.plist = inst.partitionLists[s];
+		father.plist = inst.partitionLists[(s + 1) % NUM_SAMPLES];
+		daughter.combine(mother, father, PARTITION_SIZE);
+		benchmark::DoNotOptimize(daughter.plist.data());
+		return 0;
+	});
+}
+BENCHMARK(BM_PartitionListCombine)->Apply(registerForAllInstances);
+
+static void BM_NeighborhoodSwap(benchmark::State &state) {
+	measure(state, [](BenchInstance &inst, int s) {
+		Lambda indiv(inst.orders[s]);
+		indiv.neighborhoodSwap(inst.p->adjMx, 5, true);
+		benchmark::DoNotOptimize(indiv.order.data());
+		return 0;
+	});
+}
+BENCHMARK(BM_NeighborhoodSwap)->Apply(registerForAllInstances);
+
+static void BM_LambdaZrtMutation(benchmark::State &state) {
+	measure(state, [](BenchInstance &inst, int s) {
+		LambdaZrt indiv(inst.orders[s], inst.zrts[s]);
+		indiv.independentMutations(inst.p->adjMx, inst.p->zmax, 5);
+		benchmark::DoNotOptimize(indiv.order.data());
+		return 0;
+	});
+}
+BENCHMARK(BM_LambdaZrtMutation)->Apply(registerForAllInstances);
+
+static void BM_RandomKeyMutation(benchmark::State &state) {
+	measure(state, [](BenchInstance &inst, int s) {
+		RandomKey indiv(inst.randomKeys[s]);
+		indiv.mutate(5);
+		benchmark::DoNotOptimize(indiv.priorities.data());
+		return 0;
+	});
+}
+BENCHMARK(BM_RandomKeyMutation)->Apply(registerForAllInstances);
+
+static void BM_PartitionSwap(benchmark::State &state) {
+	measure(state, [](BenchInstance &inst, int s) {
+		PartitionList indiv;
+		indiv.plist = inst.partitionLists[s];
+		indiv.partitionSwap(inst.p->adjMx, 5, PARTITION_SIZE);
+		benchmark::DoNotOptimize(indiv.plist.data());
+		return 0;
+	});
+}
+BENCHMARK(BM_PartitionSwap)->Apply(registerForAllInstances);
+
+//======================================================================================================================
+// Scaling with the number of jobs of generated instances, argument is the number of real jobs
+
+static void BM_Scaling_Setup(benchmark::State &state) {
+	const int numJobs = static_cast<int>(state.range(0));
+	const string &contents = scalingInstanceContents(numJobs);
+	for(auto _ : state) {
+		ProjectWithOvertime p("scaling" + to_string(numJobs), contents);
+		benchmark::DoNotOptimize(p.topOrder.data());
+	}
+	state.counters["projects/s"] = benchmark::Counter(static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_Scaling_Setup)->Apply(registerForScalingJobCounts)->Unit(benchmark::kMillisecond);
+
+static void BM_Scaling_Decode(benchmark::State &state) {
+	measureOn(state, scalingInstance(static_cast<int>(state.range(0))), [](BenchInstance &inst, int s) {
+		const SGSResult res = inst.p->serialSGSWithForwardBackwardImprovement(inst.orders[s], inst.zrs[s]);
+		benchmark::DoNotOptimize(res.sts.data());
+		return res.numSchedulesGenerated;
+	});
+}
+BENCHMARK(BM_Scaling_Decode)->Apply(registerForScalingJobCounts)->Unit(benchmark::kMicrosecond);
+
+static void BM_Scaling_GA(benchmark::State &state) {
+	const int GA_INDEX = 3, SCHEDULE_LIMIT = 2000;
+	ProjectWithOvertime &p = *scalingInstance(static_cast<int>(state.range(0))).p;
+	ScopedTempWorkingDirectory tempDir;
+
+	int64_t numSchedules = 0;
+	for(auto _ : state) {
+		Utils::seedRandomEngine(23);
+		GAParameters params = Runners::defaultParameters();
+		params.timeLimit = -1.0;
+		params.iterLimit = SCHEDULE_LIMIT;
+		params.traceobj = true;
+		const Runners::GAResult result = Runners::run(p, params, GA_INDEX);
+		numSchedules += result.anytimeCurve.empty() ? 0 : result.anytimeCurve.back().nschedules;
+	}
+	state.counters["schedules/s"] = benchmark::Counter(static_cast<double>(numSchedules), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_Scaling_GA)->Apply(registerForScalingJobCounts)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
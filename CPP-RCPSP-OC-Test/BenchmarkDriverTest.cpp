@@ -0,0 +1,30 @@
+#include <gtest/gtest.h>
+#include "../BenchmarkDriver.h"
+
+using namespace std;
+
+namespace {
+	const vector<Utils::Tracer::TracePoint> curve = {
+		{ 1.0, 50.0f, 100, 10 },
+		{ 2.0, 90.0f, 200, 20 },
+		{ 4.0, 100.0f, 400, 40 }
+	};
+}
+
+TEST(BenchmarkDriverTest, testGapToBest) {
+	ASSERT_DOUBLE_EQ(0.0, BenchmarkDriver::gapToBest(100.0f, 100.0f));
+	ASSERT_NEAR(0.1, BenchmarkDriver::gapToBest(90.0f, 100.0f), 1e-6);
+	ASSERT_NEAR(0.5, BenchmarkDriver::gapToBest(-150.0f, -100.0f), 1e-6);
+}
+
+TEST(BenchmarkDriverTest, testTimeToTarget) {
+	ASSERT_DOUBLE_EQ(2.0, BenchmarkDriver::timeToTarget(curve, 100.0f, 0.1));
+	ASSERT_DOUBLE_EQ(4.0, BenchmarkDriver::timeToTarget(curve, 100.0f, 0.0));
+	ASSERT_DOUBLE_EQ(-1.0, BenchmarkDriver::timeToTarget(curve, 200.0f, 0.1));
+}
+
+TEST(BenchmarkDriverTest, testGapAreaUnderCurve) {
+	// gap 1 on [0,1), 0.5 on [1,2), 0.1 on [2,4), 0 on [4,5]
+	ASSERT_NEAR((1.0 + 0.5 + 0.2) / 5.0, BenchmarkDriver::gapAreaUnderCurve(curve, 100.0f, 5.0), 1e-6);
+	ASSERT_DOUBLE_EQ(1.0, BenchmarkDriver::gapAreaUnderCurve({}, 100.0f, 5.0));
+}
@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include "../Bounds.h"
+#include "../BranchAndBound.h"
+#include "../ProjectWithOvertime.h"
+#include "../Runners.h"
+#include "../GeneticAlgorithms/Sampling.h"
+#include "TestHelpers.h"
+
+using namespace std;
+
+TEST(BoundsTest, testMakespanLowerBoundsHoldForSchedules) {
+	ProjectWithOvertime p("Data/j3025_4.sm");
+	const Bounds bounds(p);
+	const vector<int> noOvertime(p.numRes, 0);
+
+	ASSERT_EQ(p.ests[p.lastJob], bounds.criticalPathMakespan());
+	ASSERT_LE(bounds.makespanLowerBound(true), bounds.makespanLowerBound(false));
+
+	for(int i = 0; i < 20; i++) {
+		const vector<int> order = Sampling::regretBasedBiasedRandomSamplingForLfts(p);
+		ASSERT_LE(bounds.makespanLowerBound(true), p.makespan(p.serialSGS(order, p.zmax)));
+		ASSERT_LE(bounds.makespanLowerBound(false), p.makespan(p.serialSGS(order, noOvertime)));
+	}
+}
+
+TEST(BoundsTest, testProfitUpperBoundDominatesOptimum) {
+	for(int seed = 1; seed <= 4; seed++) {
+		auto p = TestHelpers::generatedInstance(8, 1 + seed % 3, 0.2f, seed);
+		const Bounds bounds(*p);
+		BranchAndBound b(*p, -1.0, -1);
+		const float optimalProfit = p->calcProfit(b.solve());
+		ASSERT_GE(bounds.profitUpperBound() + 1e-4f, optimalProfit);
+
+		const vector<float> boundsByMakespan = bounds.profitUpperBounds();
+		ASSERT_FLOAT_EQ(*max_element(boundsByMakespan.begin(), boundsByMakespan.end()), bounds.profitUpperBound());
+	}
+}
+
+TEST(BoundsTest, testPartialProfitUpperBoundDominatesCompletion) {
+	ProjectWithOvertime p("Data/j3025_4.sm");
+	const Bounds bounds(p);
+
+	for(int i = 0; i < 10; i++) {
+		const vector<int> sts = p.serialSGS(Sampling::regretBasedBiasedRandomSamplingForLfts(p), p.zmax).sts;
+		const float profit = p.calcProfit(sts);
+
+		vector<int> jobsByStart(p.numJobs);
+		iota(jobsByStart.begin(), jobsByStart.end(), 0);
+		stable_sort(jobsByStart.begin(), jobsByStart.end(), [&sts](int a, int b) { return sts[a] < sts[b]; });
+
+		Bounds::Profile profile = bounds.emptyProfile();
+		const Bounds::Profile emptyProfile = profile;
+		int msMin = 0;
+		for(int k = 0; k < p.numJobs; k++) {
+			const int j = jobsByStart[k];
+			bounds.fixJob(profile, j, sts[j]);
+			msMin = Utils::max(msMin, sts[j] + bounds.getTails()[j]);
+			const int earliestStart = k + 1 < p.numJobs ? sts[jobsByStart[k + 1]] : sts[j];
+			ASSERT_GE(bounds.partialProfitUpperBound(profile, msMin, earliestStart) + 1e-3f, profit);
+		}
+		ASSERT_FLOAT_EQ(p.totalCosts(sts), bounds.costs(profile));
+
+		for(int k = p.numJobs - 1; k >= 0; k--)
+			bounds.releaseJob(profile, jobsByStart[k], sts[jobsByStart[k]]);
+		ASSERT_EQ(emptyProfile.overtime, profile.overtime);
+		ASSERT_EQ(emptyProfile.missingWork, profile.missingWork);
+	}
+}
+
+TEST(BoundsTest, testGeneticAlgorithmStopsAtProfitBound) {
+	// the profit upper bound of this instance is attained by the optimum
+	auto p = TestHelpers::generatedInstance(10, 1, 0.5f, 24);
+	const float profitBound = Bounds(*p).profitUpperBound();
+
+	// without the bound the run would only end at the schedule limit
+	GAParameters params = Runners::defaultParameters();
+	params.timeLimit = -1.0;
+	params.iterLimit = 100000;
+	params.traceobj = true;
+	params.stopAtProfitBound = true;
+	ScopedTempWorkingDirectory tempDir;
+	const Runners::GAResult result = Runners::run(*p, params, 3);
+	ASSERT_FLOAT_EQ(profitBound, p->calcProfit(result.sts));
+	ASSERT_FALSE(result.anytimeCurve.empty());
+	ASSERT_LT(result.anytimeCurve.back().nschedules, params.iterLimit / 10);
+}
@@ -0,0 +1,263 @@
+#include <gtest/gtest.h>
+#include <boost/filesystem.hpp>
+#include "../BranchAndBound.h"
+#include "../ProjectWithOvertime.h"
+#include "TestHelpers.h"
+
+using namespace std;
+
+namespace {
+	void assertPrecedenceFeasible(const ProjectWithOvertime &p, const vector<int> &sts) {
+		for(int j = 0; j < p.numJobs; j++)
+			for(int i : p.preds[j])
+				ASSERT_LE(sts[i] + p.durations[i], sts[j]);
+	}
+}
+
+TEST(BranchAndBoundTest, testCompleteSearchIsFeasibleAndNotWorseThanHeuristic) {
+	for(int seed = 1; seed <= 3; seed++) {
+		auto p = TestHelpers::smallInstance(seed);
+		BranchAndBound b(*p, -1.0, -1);
+		const vector<int> sts = b.solve();
+		assertPrecedenceFeasible(*p, sts);
+		ASSERT_TRUE(p->isScheduleResourceFeasible(sts));
+		ASSERT_GE(p->calcProfit(sts), p->calcProfit(p->serialSGS(p->topOrder)));
+	}
+}
+
+TEST(BranchAndBoundTest, testCompleteSearchIsDeterministic) {
+	auto p = TestHelpers::smallInstance(3);
+	Utils::seedRandomEngine(5);
+	BranchAndBound first(*p, -1.0, -1);
+	const vector<int> firstSts = first.solve();
+	Utils::seedRandomEngine(5);
+	BranchAndBound second(*p, -1.0, -1);
+	ASSERT_EQ(firstSts, second.solve());
+	ASSERT_EQ(first.getNodeCount(), second.getNodeCount());
+}
+
+TEST(BranchAndBoundTest, testRespectsNodeLimit) {
+	ProjectWithOvertime p("Data/j3025_4.sm");
+	BranchAndBound b(p, -1.0, 5000);
+	const vector<int> sts = b.solve();
+	ASSERT_EQ(5000, b.getNodeCount());
+	assertPrecedenceFeasible(p, sts);
+}
+
+TEST(BranchAndBoundTest, testParallelCompleteSearchFindsSameProfit) {
+	for(int seed = 1; seed <= 3; seed++) {
+		auto p = TestHelpers::smallInstance(seed);
+		BranchAndBound sequential(*p, -1.0, -1);
+		BranchAndBound parallel(*p, -1.0, -1, false, 4);
+		const vector<int> sts = parallel.solve();
+		assertPrecedenceFeasible(*p, sts);
+		ASSERT_TRUE(p->isScheduleResourceFeasible(sts));
+		ASSERT_FLOAT_EQ(p->calcProfit(sequential.solve()), p->calcProfit(sts));
+	}
+}
+
+TEST(BranchAndBoundTest, testParallelRespectsGlobalNodeLimit) {
+	ProjectWithOvertime p("Data/j3025_4.sm");
+	BranchAndBound b(p, -1.0, 5000, false, 4);
+	b.solve();
+	ASSERT_EQ(5000, b.getNodeCount());
+}
+
+TEST(BranchAndBoundTest, testTranspositionTableKeepsProfitAndPrunesNodes) {
+	for(int seed = 1; seed <= 3; seed++) {
+		auto p = TestHelpers::smallInstance(seed);
+		BranchAndBound plain(*p, -1.0, -1);
+		plain.setTranspositionTableBudget(0);
+		const float plainProfit = p->calcProfit(plain.solve());
+		ASSERT_EQ(0, plain.getTranspositionStatistics().lookups);
+
+		BranchAndBound pruned(*p, -1.0, -1);
+		ASSERT_FLOAT_EQ(plainProfit, p->calcProfit(pruned.solve()));
+		ASSERT_LE(pruned.getNodeCount(), plain.getNodeCount());
+
+		// a table of a few buckets replaces entries all the time and must stay exact
+		BranchAndBound tiny(*p, -1.0, -1);
+		tiny.setTranspositionTableBudget(1000);
+		ASSERT_FLOAT_EQ(plainProfit, p->calcProfit(tiny.solve()));
+		ASSERT_GT(tiny.getTranspositionStatistics().replacements, 0);
+	}
+}
+
+TEST(BranchAndBoundTest, testDominanceRulesAgreeWithExhaustiveSearch) {
+	const vector<BranchAndBound::DominanceRules> ruleSets = {
+		{ true, false, false },
+		{ true, true, false },
+		{ true, false, true },
+		{ true, true, true }
+	};
+
+	int numDominancePrunings = 0;
+	for(int seed = 1; seed <= 6; seed++) {
+		auto p = TestHelpers::smallInstance(seed);
+		BranchAndBound exhaustive(*p, -1.0, -1);
+		exhaustive.setTranspositionTableBudget(0);
+		exhaustive.setDominanceRules({ false, false, false });
+		const float optimalProfit = p->calcProfit(exhaustive.solve());
+		ASSERT_EQ(0, exhaustive.getDominanceCount());
+
+		for(const auto &rules : ruleSets) {
+			BranchAndBound b(*p, -1.0, -1);
+			b.setTranspositionTableBudget(0);
+			b.setDominanceRules(rules);
+			const vector<int> sts = b.solve();
+			assertPrecedenceFeasible(*p, sts);
+			ASSERT_FLOAT_EQ(optimalProfit, p->calcProfit(sts));
+			numDominancePrunings += b.getDominanceCount();
+		}
+	}
+	ASSERT_GT(numDominancePrunings, 0);
+}
+
+TEST(BranchAndBoundTest, testPropagationKeepsProfitAndPrunesNodes) {
+	int numNodesWithout = 0, numNodesWith = 0;
+	for(int seed = 1; seed <= 6; seed++) {
+		auto p = TestHelpers::smallInstance(seed);
+		BranchAndBound without(*p, -1.0, -1);
+		const float optimalProfit = p->calcProfit(without.solve());
+		numNodesWithout += without.getNodeCount();
+
+		for(bool edgeFinding : { false, true }) {
+			BranchAndBound b(*p, -1.0, -1);
+			b.setPropagation(true, edgeFinding);
+			const vector<int> sts = b.solve();
+			assertPrecedenceFeasible(*p, sts);
+			ASSERT_TRUE(p->isScheduleResourceFeasible(sts));
+			ASSERT_FLOAT_EQ(optimalProfit, p->calcProfit(sts));
+			if(!edgeFinding) numNodesWith += b.getNodeCount();
+		}
+	}
+	ASSERT_LE(numNodesWith, numNodesWithout);
+}
+
+TEST(BranchAndBoundTest, testBestFirstSearchIsExact) {
+	BranchAndBound::StrategyParameters bestFirst;
+	bestFirst.type = BranchAndBound::Strategy::BestFirst;
+	BranchAndBound::StrategyParameters bounded = bestFirst;
+	bounded.openNodesBudgetBytes = 1000;
+
+	for(int seed = 1; seed <= 3; seed++) {
+		auto p = TestHelpers::smallInstance(seed);
+		BranchAndBound depthFirst(*p, -1.0, -1);
+		const float optimalProfit = p->calcProfit(depthFirst.solve());
+
+		for(const auto &params : { bestFirst, bounded }) {
+			BranchAndBound b(*p, -1.0, -1);
+			b.setStrategy(params);
+			const vector<int> sts = b.solve();
+			assertPrecedenceFeasible(*p, sts);
+			ASSERT_FLOAT_EQ(optimalProfit, p->calcProfit(sts));
+			ASSERT_FLOAT_EQ(optimalProfit, b.getUpperBound());
+		}
+	}
+}
+
+TEST(BranchAndBoundTest, testBestFirstUpperBoundIsValidWhenLimited) {
+	auto p = TestHelpers::smallInstance(1);
+	BranchAndBound depthFirst(*p, -1.0, -1);
+	const float optimalProfit = p->calcProfit(depthFirst.solve());
+
+	BranchAndBound::StrategyParameters params;
+	params.type = BranchAndBound::Strategy::BestFirst;
+	BranchAndBound b(*p, -1.0, 10);
+	b.setStrategy(params);
+	b.solve();
+	ASSERT_GE(b.getUpperBound(), optimalProfit);
+}
+
+TEST(BranchAndBoundTest, testHeuristicStrategiesAreFeasible) {
+	BranchAndBound::StrategyParameters beam;
+	beam.type = BranchAndBound::Strategy::Beam;
+	beam.beamWidth = 4;
+	BranchAndBound::StrategyParameters lds;
+	lds.type = BranchAndBound::Strategy::LimitedDiscrepancy;
+	lds.maxDiscrepancies = 2;
+
+	for(int seed = 1; seed <= 3; seed++) {
+		auto p = TestHelpers::smallInstance(seed);
+		BranchAndBound depthFirst(*p, -1.0, -1);
+		const float optimalProfit = p->calcProfit(depthFirst.solve());
+
+		for(const auto &params : { beam, lds }) {
+			BranchAndBound b(*p, -1.0, -1);
+			b.setStrategy(params);
+			const vector<int> sts = b.solve();
+			assertPrecedenceFeasible(*p, sts);
+			ASSERT_LE(p->calcProfit(sts), optimalProfit + 1e-4f);
+		}
+	}
+}
+
+TEST(BranchAndBoundTest, testStrategyFromSuffix) {
+	int threadCount;
+	ASSERT_EQ(BranchAndBound::Strategy::DepthFirst, BranchAndBound::strategyFromSuffix("", threadCount).type);
+	ASSERT_EQ(1, threadCount);
+	ASSERT_EQ(BranchAndBound::Strategy::DepthFirst, BranchAndBound::strategyFromSuffix("4", threadCount).type);
+	ASSERT_EQ(4, threadCount);
+	ASSERT_EQ(BranchAndBound::Strategy::BestFirst, BranchAndBound::strategyFromSuffix("BestFirst", threadCount).type);
+	ASSERT_EQ(16, BranchAndBound::strategyFromSuffix("Beam16", threadCount).beamWidth);
+	ASSERT_EQ(2, BranchAndBound::strategyFromSuffix("LDS2", threadCount).maxDiscrepancies);
+	ASSERT_THROW(BranchAndBound::strategyFromSuffix("Breadth", threadCount), runtime_error);
+}
+
+TEST(BranchAndBoundTest, testResumedSearchMatchesUninterruptedSearch) {
+	ScopedTempWorkingDirectory tempDir;
+	const string checkpointFilename = "BranchAndBoundTestCheckpoint.bin";
+
+	for(int seed = 1; seed <= 3; seed++) {
+		for(bool propagation : { false, true }) {
+			auto p = TestHelpers::smallInstance(seed);
+			BranchAndBound uninterrupted(*p, -1.0, -1);
+			uninterrupted.setPropagation(propagation);
+			uninterrupted.setTranspositionTableBudget(64 * 1024);
+			const float optimalProfit = p->calcProfit(uninterrupted.solve());
+
+			// every run stops after a few more nodes and the next one resumes from its checkpoint
+			int runs = 0;
+			for(int iterLimit = 25; ; iterLimit += 25, runs++) {
+				BranchAndBound b(*p, -1.0, iterLimit);
+				b.setPropagation(propagation);
+				b.setTranspositionTableBudget(64 * 1024);
+				b.setCheckpoint(checkpointFilename, 0.0);
+				const vector<int> sts = b.solve();
+				if(!boost::filesystem::exists(checkpointFilename)) {
+					assertPrecedenceFeasible(*p, sts);
+					ASSERT_FLOAT_EQ(optimalProfit, p->calcProfit(sts));
+					ASSERT_EQ(uninterrupted.getNodeCount(), b.getNodeCount());
+					ASSERT_EQ(uninterrupted.getBoundCount(), b.getBoundCount());
+					ASSERT_EQ(uninterrupted.getDominanceCount(), b.getDominanceCount());
+					break;
+				}
+			}
+			ASSERT_GT(runs, 0);
+		}
+	}
+}
+
+TEST(BranchAndBoundTest, testCheckpointRejectsOtherSettings) {
+	ScopedTempWorkingDirectory tempDir;
+	const string checkpointFilename = "BranchAndBoundTestCheckpoint.bin";
+	auto p = TestHelpers::smallInstance(1);
+	BranchAndBound stopped(*p, -1.0, 5);
+	stopped.setCheckpoint(checkpointFilename);
+	stopped.solve();
+	ASSERT_TRUE(boost::filesystem::exists(checkpointFilename));
+
+	BranchAndBound propagated(*p, -1.0, -1);
+	propagated.setPropagation(true);
+	propagated.setCheckpoint(checkpointFilename);
+	ASSERT_THROW(propagated.solve(), runtime_error);
+
+	auto other = TestHelpers::smallInstance(2);
+	BranchAndBound otherInstance(*other, -1.0, -1);
+	otherInstance.setCheckpoint(checkpointFilename);
+	ASSERT_THROW(otherInstance.solve(), runtime_error);
+
+	BranchAndBound parallel(*p, -1.0, -1, false, 4);
+	parallel.setCheckpoint(checkpointFilename);
+	ASSERT_THROW(parallel.solve(), runtime_error);
+}
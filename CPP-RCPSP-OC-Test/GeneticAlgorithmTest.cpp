@@ -0,0 +1,191 @@
+#include <gtest/gtest.h>
+#include <set>
+#include "TestHelpers.h"
+#include "../GeneticAlgorithms/GeneticAlgorithm.h"
+#include "../GeneticAlgorithms/Representations.h"
+#include "../GeneticAlgorithms/OvertimeBound.h"
+
+using namespace std;
+
+namespace {
+	// Activity list GA recording the initial individuals and the threads that decoded
+	class RecordingGA : public GeneticAlgorithm<Lambda> {
+	public:
+		RecordingGA(ProjectWithOvertime &_p, bool reentrant, int popSize) : GeneticAlgorithm(_p, "RecordingGA"), initialOrders(static_cast<size_t>(popSize * 2)) {
+			reentrantDecoding = reentrant;
+		}
+
+		vector<vector<int>> initialOrders;
+		set<thread::id> decodingThreads;
+
+	protected:
+		Lambda init(int ix) override {
+			Lambda l;
+			l.order = Sampling::sample(true, p);
+			initialOrders[ix] = l.order;
+			return l;
+		}
+
+		void crossover(Lambda &mother, Lambda &father, Lambda &daughter) override {
+			daughter.randomOnePointCrossover(mother, father);
+		}
+
+		void mutate(Lambda &i) override {
+			i.neighborhoodSwap(p.adjMx, params.pmutate, true);
+		}
+
+		FitnessResult fitness(Lambda &i) override {
+			{
+				lock_guard<mutex> lock(threadsMutex);
+				decodingThreads.insert(this_thread::get_id());
+			}
+			return { p, p.serialSGSWithOvertimeWithForwardBackwardImprovement(i.order) };
+		}
+
+		vector<int> decode(Lambda &i) override {
+			return p.serialSGSWithOvertimeWithForwardBackwardImprovement(i.order).sts;
+		}
+
+	private:
+		mutex threadsMutex;
+	};
+
+	GAParameters threadedParameters(int popSize, int threadCount) {
+		GAParameters params;
+		params.popSize = popSize;
+		params.numGens = 4;
+		params.threadCount = threadCount;
+		return params;
+	}
+}
+
+TEST(PopulationTest, testSwapOnlyPermutesRanking) {
+	Population<Lambda> pop(4);
+	for (int i = 0; i < pop.size(); i++) {
+		pop[i].order = { i };
+		pop.fitness(i) = static_cast<float>(i);
+	}
+
+	pop.swap(1, 3);
+	ASSERT_EQ(3, pop[1].order[0]);
+	ASSERT_EQ(1, pop[3].order[0]);
+	ASSERT_EQ(3.0f, pop.fitness(1));
+	ASSERT_EQ(3, pop.arenaIndex(1));
+}
+
+TEST(PopulationTest, testSortByFitness) {
+	Population<Lambda> pop(5);
+	vector<float> fitnesses = { 3.0f, -1.0f, 7.0f, 0.0f, -5.0f };
+	for (int i = 0; i < pop.size(); i++) {
+		pop[i].order = { i };
+		pop.fitness(i) = fitnesses[i];
+	}
+
+	pop.sortByFitness();
+	vector<int> expOrder = { 4, 1, 3, 0, 2 };
+	for (int i = 0; i < pop.size(); i++) {
+		ASSERT_EQ(expOrder[i], pop[i].order[0]);
+		ASSERT_EQ(expOrder[i], pop.arenaIndex(i));
+		ASSERT_EQ(fitnesses[expOrder[i]], pop.fitness(i));
+	}
+}
+
+TEST(PopulationTest, testSwapBestToFront) {
+	Population<Lambda> pop(6);
+	vector<float> fitnesses = { 2.0f, 1.0f, -4.0f, 0.0f, -9.0f, -9.0f };
+	for (int i = 0; i < pop.size(); i++) {
+		pop[i].order = { i };
+		pop.fitness(i) = fitnesses[i];
+	}
+
+	pop.swapBestToFront(3);
+	ASSERT_EQ(2, pop[0].order[0]);
+	ASSERT_EQ(0, pop[2].order[0]);
+	ASSERT_EQ(-4.0f, pop.fitness(0));
+}
+
+TEST(PopulationTest, testExchangeWithSpareKeepsIndividualsInPlace) {
+	Population<Lambda> pop(3);
+	for (int i = 0; i < pop.size(); i++)
+		pop[i].order = { i };
+	pop.addSpares(2, pop[0]);
+	ASSERT_EQ(3, pop.size());
+	ASSERT_EQ(2, pop.numSpares());
+
+	pop.spare(1).order = { 7 };
+	const Lambda *candidate = &pop.spare(1);
+	pop.exchangeWithSpare(2, 1);
+	ASSERT_EQ(candidate, &pop[2]);
+	ASSERT_EQ(7, pop[2].order[0]);
+	ASSERT_EQ(2, pop.spare(1).order[0]);
+	ASSERT_EQ(0, pop.spare(0).order[0]);
+}
+
+TEST(GeneticAlgorithmTest, testParallelInitialPopulationIsReproducible) {
+	ProjectWithOvertime p("Data/j3025_4.sm");
+	ScopedTempWorkingDirectory tempDir;
+	const int popSize = 16, threadCount = 4;
+
+	vector<vector<vector<int>>> initialOrders;
+	vector<pair<vector<int>, float>> results;
+	for(int run = 0; run < 2; run++) {
+		Utils::seedRandomEngine(42);
+		RecordingGA ga(p, true, popSize);
+		ga.setParameters(threadedParameters(popSize, threadCount));
+		results.push_back(ga.solve());
+		initialOrders.push_back(ga.initialOrders);
+		ASSERT_GT(ga.decodingThreads.size(), 1);
+	}
+
+	ASSERT_EQ(initialOrders[0], initialOrders[1]);
+	ASSERT_EQ(results[0].first, results[1].first);
+	ASSERT_FLOAT_EQ(results[0].second, results[1].second);
+}
+
+TEST(GeneticAlgorithmTest, testNonReentrantDecodingUsesOneThread) {
+	ProjectWithOvertime p("Data/j3025_4.sm");
+	ScopedTempWorkingDirectory tempDir;
+
+	for(bool steadyState : { false, true }) {
+		RecordingGA ga(p, false, 16);
+		GAParameters params = threadedParameters(16, 4);
+		params.steadyState = steadyState;
+		ga.setParameters(params);
+		ga.solve();
+		ASSERT_EQ(1, ga.decodingThreads.size());
+	}
+}
+
+TEST(GeneticAlgorithmTest, testSurrogateRankedChildrenEnterPopulation) {
+	ProjectWithOvertime p("Data/j3025_4.sm");
+	ScopedTempWorkingDirectory tempDir;
+
+	GAParameters params = threadedParameters(16, 1);
+	params.surrogateBatchFactor = 3;
+	FixedCapacityGA ga(p);
+	GAParameters oddParams = params;
+	oddParams.popSize = 15;
+	ASSERT_THROW(ga.setParameters(oddParams), runtime_error);
+	ga.setParameters(params);
+	const auto result = ga.solve();
+	ASSERT_TRUE(p.isScheduleFeasible(result.first));
+	ASSERT_FLOAT_EQ(p.calcProfit(result.first), result.second);
+}
+
+TEST(GeneticAlgorithmTest, testPrescreenOnlyWithSelectionOfTheBest) {
+	ProjectWithOvertime p("Data/j3025_4.sm");
+	ScopedTempWorkingDirectory tempDir;
+
+	for(SelectionMethod selection : { SelectionMethod::BEST, SelectionMethod::DUEL }) {
+		GAParameters params = threadedParameters(16, 1);
+		params.fitnessPrescreen = true;
+		params.selectionMethod = selection;
+		params.traceobj = true;
+		FixedCapacityGA ga(p);
+		ga.setParameters(params);
+		ga.solve();
+		const string statisticsFilename = traceFilenameForGeneticAlgorithm(params.outPath, ga.getName(), p.instanceName) + "_Prescreen.txt";
+		ASSERT_EQ(selection == SelectionMethod::BEST, boost::filesystem::exists(statisticsFilename));
+		boost::filesystem::remove(statisticsFilename);
+	}
+}
@@ -0,0 +1,42 @@
+#include <gtest/gtest.h>
+#include "../InstanceGenerator.h"
+#include "../ProjectWithOvertime.h"
+
+using namespace std;
+
+namespace {
+	InstanceGenerator::GeneratorParameters parametersFor(int numJobs, int seed) {
+		InstanceGenerator::GeneratorParameters params;
+		params.numJobs = numJobs;
+		params.networkComplexity = 1.8f;
+		params.resourceFactor = 0.5f;
+		params.resourceStrength = 0.3f;
+		params.seed = seed;
+		return params;
+	}
+}
+
+TEST(InstanceGeneratorTest, testDeterministicForSeed) {
+	ASSERT_EQ(InstanceGenerator::generateSmContents(parametersFor(60, 1)), InstanceGenerator::generateSmContents(parametersFor(60, 1)));
+	ASSERT_NE(InstanceGenerator::generateSmContents(parametersFor(60, 1)), InstanceGenerator::generateSmContents(parametersFor(60, 2)));
+}
+
+TEST(InstanceGeneratorTest, testCharacteristicsMatchParameters) {
+	const auto params = parametersFor(120, 3);
+	ProjectWithOvertime p("generated", InstanceGenerator::generateSmContents(params));
+	ASSERT_EQ(params.numJobs + 2, p.numJobs);
+	ASSERT_EQ(params.numRes, p.numRes);
+	ASSERT_TRUE(p.isOrderFeasible(p.topOrder));
+
+	const ProjectCharacteristics chars = p.collectCharacteristics();
+	ASSERT_NEAR(params.networkComplexity, chars.getCharacteristic("nc"), 0.01f);
+	ASSERT_NEAR(params.resourceFactor, chars.getCharacteristic("rf"), 0.01f);
+	ASSERT_NEAR(params.resourceStrength, chars.getCharacteristic("rs"), 0.02f);
+}
+
+TEST(InstanceGeneratorTest, testParametersJsonRoundtrip) {
+	const auto params = parametersFor(300, 7);
+	InstanceGenerator::GeneratorParameters parsed;
+	parsed.from_json(params.to_json());
+	ASSERT_EQ(InstanceGenerator::generateSmContents(params), InstanceGenerator::generateSmContents(parsed));
+}
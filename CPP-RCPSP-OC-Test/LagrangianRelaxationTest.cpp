@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+#include "../LagrangianRelaxation.h"
+#include "../BranchAndBound.h"
+#include "../ProjectWithOvertime.h"
+#include "../Runners.h"
+#include "../GeneticAlgorithms/OvertimeBound.h"
+#include "TestHelpers.h"
+
+using namespace std;
+
+TEST(LagrangianRelaxationTest, testProfitUpperBoundDominatesOptimum) {
+	for(int seed = 1; seed <= 6; seed++) {
+		auto p = TestHelpers::generatedInstance(8, 1 + seed % 3, seed % 2 ? 0.2f : 0.5f, seed);
+		BranchAndBound b(*p, -1.0, -1);
+		const float optimalProfit = p->calcProfit(b.solve());
+
+		LagrangianRelaxation relaxation(*p);
+		const float firstBound = relaxation.profitUpperBound(optimalProfit, 1);
+		const float bound = relaxation.profitUpperBound(optimalProfit, 200);
+		ASSERT_GE(bound + 1e-3f, optimalProfit);
+		ASSERT_LE(bound, firstBound);
+		ASSERT_LE(relaxation.getIterationCount(), 200);
+	}
+}
+
+TEST(LagrangianRelaxationTest, testBoundTightensOnLargerInstance) {
+	ProjectWithOvertime p("Data/j3025_4.sm");
+	const float profit = p.calcProfit(p.serialSGS(p.topOrder, p.zmax).sts);
+
+	LagrangianRelaxation relaxation(p);
+	const float firstBound = relaxation.profitUpperBound(profit, 1);
+	const float bound = relaxation.profitUpperBound(profit, 300);
+	ASSERT_GE(bound, profit);
+	ASSERT_LT(bound, firstBound);
+}
+
+TEST(LagrangianRelaxationTest, testBranchAndBoundWithLagrangianRootBoundIsExact) {
+	for(int seed = 1; seed <= 4; seed++) {
+		auto p = TestHelpers::generatedInstance(8, 1, 0.5f, seed);
+		BranchAndBound plain(*p, -1.0, -1);
+		const float optimalProfit = p->calcProfit(plain.solve());
+
+		BranchAndBound b(*p, -1.0, -1);
+		b.setLagrangianIterations(200);
+		ASSERT_FLOAT_EQ(optimalProfit, p->calcProfit(b.solve()));
+		ASSERT_FLOAT_EQ(optimalProfit, b.getUpperBound());
+	}
+}
+
+TEST(LagrangianRelaxationTest, testGeneticAlgorithmReportsOptimalityGap) {
+	// the profit upper bounds of this instance exceed its optimum
+	auto p = TestHelpers::generatedInstance(8, 3, 0.2f, 5);
+	GAParameters params = Runners::defaultParameters();
+	params.iterLimit = 2000;
+	params.lagrangianIterations = 100;
+
+	ScopedTempWorkingDirectory tempDir;
+	FixedCapacityGA ga(*p);
+	ga.setParameters(params);
+	ASSERT_LT(ga.getOptimalityGap(), 0.0f);
+	ga.solve();
+	ASSERT_GT(ga.getOptimalityGap(), 0.0f);
+	ASSERT_LT(ga.getOptimalityGap(), 1.0f);
+}
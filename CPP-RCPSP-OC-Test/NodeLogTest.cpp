@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include <boost/filesystem.hpp>
+#include <boost/algorithm/string.hpp>
+#include "../NodeLog.h"
+#include "../BranchAndBound.h"
+#include "../ProjectWithOvertime.h"
+#include "TestHelpers.h"
+
+using namespace std;
+
+namespace {
+	int countReason(const vector<NodeLog::Record> &records, NodeLog::Reason reason) {
+		return static_cast<int>(count_if(records.begin(), records.end(), [reason](const NodeLog::Record &r) { return r.reason == reason; }));
+	}
+
+	vector<NodeLog::Record> solveWithNodeLog(ProjectWithOvertime &p, BranchAndBound &b) {
+		b.solve();
+		const string filename = BranchAndBound::getNodeLogFilename("", p.instanceName);
+		const auto records = NodeLog::read(filename);
+		boost::filesystem::remove(filename);
+		return records;
+	}
+}
+
+TEST(NodeLogTest, testRecordsSurviveRoundTripThroughSmallBuffer) {
+	const string filename = "NodeLogTest.bin";
+	const vector<NodeLog::Record> records = {
+		{ 1, 0, 0, 0, 120.5f, NodeLog::Reason::Visited },
+		{ -1, 1, 3, 7, 99.0f, NodeLog::Reason::Bound },
+		{ 2, 1, 2, 4, 110.25f, NodeLog::Reason::Visited },
+		{ -1, 2, 5, 9, -3.0f, NodeLog::Reason::Transposition },
+		{ 2, 2, 9, 17, 101.0f, NodeLog::Reason::Leaf }
+	};
+	{
+		NodeLog log(filename, 2);
+		for(const auto &record : records)
+			log.append(record);
+		ASSERT_EQ(records.size(), log.getRecordCount());
+	}
+
+	const auto read = NodeLog::read(filename);
+	ASSERT_EQ(records.size(), read.size());
+	for(size_t i = 0; i < records.size(); i++) {
+		ASSERT_EQ(records[i].node, read[i].node);
+		ASSERT_EQ(records[i].parent, read[i].parent);
+		ASSERT_EQ(records[i].job, read[i].job);
+		ASSERT_EQ(records[i].start, read[i].start);
+		ASSERT_EQ(records[i].bound, read[i].bound);
+		ASSERT_EQ(records[i].reason, read[i].reason);
+	}
+
+	Utils::spit("digraph{}", filename);
+	ASSERT_THROW(NodeLog::read(filename), runtime_error);
+	boost::filesystem::remove(filename);
+}
+
+TEST(NodeLogTest, testBranchAndBoundLogsEveryNodeAndPruning) {
+	for(int seed = 1; seed <= 3; seed++) {
+		auto p = TestHelpers::smallInstance(seed);
+		BranchAndBound b(*p, -1.0, -1, true);
+		const auto records = solveWithNodeLog(*p, b);
+
+		ASSERT_EQ(b.getNodeCount(), countReason(records, NodeLog::Reason::Visited));
+		ASSERT_EQ(b.getBoundCount(), countReason(records, NodeLog::Reason::Bound) + countReason(records, NodeLog::Reason::Propagation));
+		ASSERT_EQ(b.getDominanceCount(), countReason(records, NodeLog::Reason::Dominance));
+		ASSERT_GT(countReason(records, NodeLog::Reason::Leaf), 0);
+
+		// nodes are numbered in visiting order, so every parent is logged before its children
+		int lastNode = 0;
+		for(const auto &r : records) {
+			ASSERT_LE(r.parent, lastNode);
+			if(r.reason == NodeLog::Reason::Visited)
+				ASSERT_EQ(++lastNode, r.node);
+		}
+	}
+}
+
+TEST(NodeLogTest, testParallelSearchLogsEveryNodeOnce) {
+	auto p = TestHelpers::smallInstance(2);
+	BranchAndBound b(*p, -1.0, -1, true, 4);
+	const auto records = solveWithNodeLog(*p, b);
+
+	vector<int> visits(static_cast<size_t>(b.getNodeCount()) + 1, 0);
+	for(const auto &r : records)
+		if(r.reason == NodeLog::Reason::Visited)
+			visits[r.node]++;
+	for(int node = 1; node <= b.getNodeCount(); node++)
+		ASSERT_EQ(1, visits[node]);
+}
+
+TEST(NodeLogTest, testConvertsToDotAndCsv) {
+	auto p = TestHelpers::smallInstance(1);
+	BranchAndBound b(*p, -1.0, -1, true);
+	b.solve();
+	const string filename = BranchAndBound::getNodeLogFilename("", p->instanceName);
+	const auto records = NodeLog::read(filename);
+
+	NodeLog::convert(filename, "NodeLogTest.dot");
+	NodeLog::convert(filename, "NodeLogTest.csv");
+	const string dot = Utils::slurp("NodeLogTest.dot");
+	ASSERT_TRUE(boost::starts_with(dot, "digraph"));
+	ASSERT_NE(string::npos, dot.find("1->2"));
+	const string csv = Utils::slurp("NodeLogTest.csv");
+	ASSERT_EQ(records.size() + 1, count(csv.begin(), csv.end(), '\n'));
+
+	for(const string &fn : { filename, string("NodeLogTest.dot"), string("NodeLogTest.csv") })
+		boost::filesystem::remove(fn);
+}
@@ -4,6 +4,7 @@
 
 #include "ProjectTest.h"
 #include "TestHelpers.h"
+#include "../Utils.h"
 
 #include <gtest/gtest.h>
 
@@ -182,4 +183,63 @@ TEST_F(ProjectTest, testEarliestJobInScheduleNotAlreadyTaken) {
 	ASSERT_EQ(1, p->earliestJobInScheduleNotAlreadyTaken({ 0, 2, 4, 0, 6 }, { true, false, false, true, false }));
 	ASSERT_EQ(2, p->earliestJobInScheduleNotAlreadyTaken({ 0, 2, 4, 0, 6 }, { true, true, false, true, false }));
 	ASSERT_EQ(4, p->earliestJobInScheduleNotAlreadyTaken({ 0, 2, 4, 0, 6 }, { true, true, true, true, false }));
-}
\ No newline at end of file
+}
+TEST(ProjectCheckpointTest, testSerialSGSResumedFromCheckpointsMatchesFullRun) {
+	Project p("Data/j3025_4.sm");
+	vector<int> z(p.numRes, 1);
+
+	SGSCheckpoints motherCheckpoints;
+	auto motherRes = p.serialSGS(p.topOrder, z, nullptr, motherCheckpoints, 4);
+	TestHelpers::arrayEquals(p.serialSGS(p.topOrder, z).sts, motherRes.sts);
+	ASSERT_EQ(4, motherCheckpoints.snapshots.size());
+	ASSERT_EQ(0, motherCheckpoints.resumedPosition);
+
+	// Move the last job that can be swapped with its predecessor, keeping the prefix before it intact
+	vector<int> childOrder = p.topOrder;
+	int swapIx = p.numJobs - 2;
+	while (p.adjMx(childOrder[swapIx - 1], childOrder[swapIx])) swapIx--;
+	swap(childOrder[swapIx - 1], childOrder[swapIx]);
+
+	SGSCheckpoints childCheckpoints;
+	auto childRes = p.serialSGS(childOrder, z, &motherCheckpoints, childCheckpoints, 4);
+	TestHelpers::arrayEquals(p.serialSGS(childOrder, z).sts, childRes.sts);
+	TestHelpers::matrixEquals(p.serialSGS(childOrder, z).resRem, childRes.resRem);
+	ASSERT_GT(childCheckpoints.resumedPosition, 0);
+	ASSERT_LE(childCheckpoints.resumedPosition, swapIx - 1);
+
+	vector<int> otherZ(p.numRes, 0);
+	SGSCheckpoints otherZCheckpoints;
+	p.serialSGS(childOrder, otherZ, &motherCheckpoints, otherZCheckpoints, 4);
+	ASSERT_EQ(0, otherZCheckpoints.resumedPosition);
+}
+
+TEST(ProjectCheckpointTest, testSerialSGSResumesWhenTimeVaryingOvertimeOnlyDiffersLater) {
+	Project p("Data/j3025_4.sm");
+	Matrix<int> z(p.numRes, p.numPeriods, 1);
+
+	SGSCheckpoints motherCheckpoints;
+	p.serialSGS(p.topOrder, z, nullptr, motherCheckpoints, 4);
+	ASSERT_EQ(4, motherCheckpoints.snapshots.size());
+
+	// Overtime changes right after the second snapshot's latest finish, so only the first two remain valid
+	const SGSCheckpoint &second = *motherCheckpoints.snapshots[1];
+	ASSERT_LT(second.lastFinish, motherCheckpoints.snapshots[2]->lastFinish);
+	Matrix<int> childZ = z;
+	for(int r = 0; r < p.numRes; r++)
+		childZ(r, second.lastFinish + 1) = 0;
+
+	SGSCheckpoints childCheckpoints;
+	auto childRes = p.serialSGS(p.topOrder, childZ, &motherCheckpoints, childCheckpoints, 4);
+	TestHelpers::arrayEquals(p.serialSGS(p.topOrder, childZ).sts, childRes.sts);
+	TestHelpers::matrixEquals(p.serialSGS(p.topOrder, childZ).resRem, childRes.resRem);
+	ASSERT_EQ(second.position, childCheckpoints.resumedPosition);
+}
+
+TEST(ProjectCyclicTest, testConstructorThrowsOnCyclicPrecedenceNetwork) {
+	string contents = Utils::slurp("Data/j3025_4.sm");
+	const string jobTwoLine = "   2        1          3          16  18  25";
+	ASSERT_NE(string::npos, contents.find(jobTwoLine));
+	// Job 2 additionally precedes job 1 which already precedes job 2
+	contents.replace(contents.find(jobTwoLine), jobTwoLine.size(), "   2        1          4           1  16  18  25");
+	ASSERT_THROW(ProjectWithOvertime("cyclic", contents), runtime_error);
+}
@@ -5,6 +5,7 @@
 #include <cmath>
 #include "ProjectWithOvertimeTest.h"
 #include "TestHelpers.h"
+#include "../GeneticAlgorithms/Sampling.h"
 
 using namespace std;
 
@@ -49,4 +50,19 @@ TEST_F(ProjectWithOvertimeTest, testOrderInducedPartitionsToPartitionList) {
 
 TEST_F(ProjectWithOvertimeTest, testPlotToAscii) {
 	const string res = p->plotAsAscii(p->serialSGS(p->topOrder), 0);
-}
\ No newline at end of file
+}
+TEST(ProjectWithOvertimeBoundTest, testProfitUpperBoundDominatesImprovedSchedules) {
+	ProjectWithOvertime p("Data/j3025_4.sm");
+	const int msLb = p.makespanLowerBound();
+	ASSERT_GE(msLb, p.ests[p.lastJob]);
+	const vector<float> bounds = p.profitUpperBounds();
+
+	for(int i = 0; i < 20; i++) {
+		vector<int> order = Sampling::regretBasedBiasedRandomSamplingForLfts(p);
+		vector<int> z = Utils::constructVector<int>(p.numRes, [&p](int r) { return Utils::randRangeIncl(0, p.zmax[r]); });
+		SGSResult res = p.serialSGS(order, z);
+		SGSResult improved = p.forwardBackwardIterations(order, res, p.makespan(res));
+		ASSERT_LE(msLb, p.makespan(improved));
+		ASSERT_GE(bounds[p.makespan(res)] + 0.001f, p.calcProfit(improved));
+	}
+}
@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include "../Propagator.h"
+#include "../ProjectWithOvertime.h"
+#include "../GeneticAlgorithms/Sampling.h"
+
+using namespace std;
+
+namespace {
+	void assertWindowsContain(const Propagator &propagator, const vector<int> &sts) {
+		ASSERT_TRUE(propagator.isConsistent());
+		for(int j = 0; j < static_cast<int>(sts.size()); j++) {
+			ASSERT_LE(propagator.est(j), sts[j]);
+			ASSERT_GE(propagator.lst(j), sts[j]);
+		}
+	}
+}
+
+TEST(PropagatorTest, testWindowsContainFeasibleSchedules) {
+	ProjectWithOvertime p("Data/j3025_4.sm");
+
+	for(bool edgeFinding : { false, true }) {
+		for(int i = 0; i < 10; i++) {
+			const vector<int> sts = p.serialSGS(Sampling::regretBasedBiasedRandomSamplingForLfts(p), p.zmax).sts;
+			Propagator propagator(p, p.makespan(sts), edgeFinding);
+			assertWindowsContain(propagator, sts);
+			const vector<int> rootEsts = propagator.getEsts(), rootLfts = propagator.getLfts();
+
+			vector<int> jobsByStart(p.numJobs);
+			iota(jobsByStart.begin(), jobsByStart.end(), 0);
+			stable_sort(jobsByStart.begin(), jobsByStart.end(), [&sts](int a, int b) { return sts[a] < sts[b]; });
+
+			for(int j : jobsByStart) {
+				ASSERT_TRUE(propagator.fix(j, sts[j]));
+				assertWindowsContain(propagator, sts);
+			}
+			ASSERT_EQ(sts, propagator.getEsts());
+
+			for(int k = 0; k < p.numJobs; k++)
+				propagator.undo();
+			ASSERT_EQ(rootEsts, propagator.getEsts());
+			ASSERT_EQ(rootLfts, propagator.getLfts());
+		}
+	}
+}
+
+TEST(PropagatorTest, testTimeTablingTightensPrecedenceWindows) {
+	ProjectWithOvertime p("Data/j3025_4.sm");
+	const vector<int> sts = p.serialSGS(p.topOrder, p.zmax).sts;
+
+	vector<int> partial(p.numJobs, Project::UNSCHEDULED);
+	bool tighter = false;
+	for(int j : p.topOrder) {
+		partial[j] = sts[j];
+		Propagator propagator(p, p.T);
+		ASSERT_TRUE(propagator.fixPartial(partial));
+
+		const vector<int> precedenceEsts = p.earliestStartingTimesForPartial(partial);
+		for(int k = 0; k < p.numJobs; k++) {
+			ASSERT_GE(propagator.est(k), precedenceEsts[k]);
+			tighter |= propagator.est(k) > precedenceEsts[k];
+		}
+	}
+	ASSERT_TRUE(tighter);
+}
+
+TEST(PropagatorTest, testDetectsInfeasibleDeadlinesAndAssignments) {
+	ProjectWithOvertime p("Data/j3025_4.sm");
+
+	ASSERT_FALSE(Propagator(p, p.ests[p.lastJob] - 1).isConsistent());
+
+	const vector<int> sts = p.serialSGS(p.topOrder, p.zmax).sts;
+	Propagator propagator(p, p.makespan(sts));
+	const int j = p.topOrder[1];
+	ASSERT_FALSE(propagator.fix(j, propagator.lst(j) + 1));
+	ASSERT_FALSE(propagator.fix(p.topOrder[2], sts[p.topOrder[2]]));
+	propagator.undo();
+	propagator.undo();
+	ASSERT_TRUE(propagator.isConsistent());
+	ASSERT_TRUE(propagator.fix(j, sts[j]));
+}
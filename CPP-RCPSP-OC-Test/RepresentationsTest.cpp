@@ -60,4 +60,49 @@ TEST_F(LambdaZrtTest, testIndependentTwoPointCrossover) {
 
 	TestHelpers::arrayEquals(expDaughter.order, lzrt->order);
 	TestHelpers::matrixEquals(expDaughter.z, lzrt->z);
-}
\ No newline at end of file
+}
+TEST_F(LambdaTest, testOnePointCrossoverCarriesBeta) {
+	LambdaBeta m({ 0, 1, 3, 2, 4 }, { 0, 1, 1, 0, 1 }),
+			   f({ 0, 2, 3, 1, 4 }, { 1, 0, 0, 1, 0 }),
+			   daughter(p->numJobs);
+	daughter.onePointCrossover(m, f, 1);
+	TestHelpers::arrayEquals({ 0, 1, 2, 3, 4 }, daughter.order);
+	TestHelpers::arrayEquals({ 0, 1, 0, 0, 0 }, daughter.beta);
+}
+
+TEST_F(LambdaTest, testSeparateOnePointCrossoverKeepsBetaPositions) {
+	LambdaBeta m({ 0, 1, 3, 2, 4 }, { 1, 0, 1, 0, 1 }),
+			   f({ 0, 2, 3, 1, 4 }, { 0, 1, 0, 1, 0 }),
+			   daughter(p->numJobs);
+	for(int k = 0; k < 20; k++) {
+		daughter.separateOnePointCrossover(m, f);
+		// a prefix of the mother's values followed by the father's values at the same positions
+		int q = 0;
+		while(q + 1 < p->numJobs && daughter.beta[q + 1] == m.beta[q + 1]) q++;
+		ASSERT_EQ(m.beta[0], daughter.beta[0]);
+		for(int i = q + 1; i < p->numJobs; i++)
+			ASSERT_EQ(f.beta[i], daughter.beta[i]);
+	}
+}
+
+TEST(PartitionListTest, testCombineKeepsPartitionSizes) {
+	const int numJobs = 12, partitionSize = 3;
+	PartitionList m(numJobs), f(numJobs), daughter(numJobs);
+	m.plist = { 0, 0, 0, 1, 1, 1, 2, 2, 2, 3, 3, 3 };
+	f.plist = { 3, 3, 3, 2, 2, 2, 1, 1, 1, 0, 0, 0 };
+
+	for(int k = 0; k < 10; k++) {
+		daughter.combine(m, f, partitionSize);
+		vector<int> partitionCounts(numJobs / partitionSize, 0);
+		for(int j = 0; j < numJobs; j++) {
+			ASSERT_GE(daughter.plist[j], 0);
+			partitionCounts[daughter.plist[j]]++;
+		}
+		for(int count : partitionCounts)
+			ASSERT_EQ(partitionSize, count);
+		// jobs 9-11 are never inherited from the mother and come first in the father
+		ASSERT_EQ(0, daughter.plist[0]);
+		ASSERT_EQ(daughter.plist[9], daughter.plist[10]);
+		ASSERT_EQ(daughter.plist[9], daughter.plist[11]);
+	}
+}
@@ -6,6 +6,7 @@
 #include <numeric>
 #include "../Project.h"
 #include "../GeneticAlgorithms/Sampling.h"
+#include "../GeneticAlgorithms/PriorityRules.h"
 #include "ProjectTest.h"
 #include "TestHelpers.h"
 
@@ -70,4 +71,66 @@ TEST_F(SamplingTest, testUpdateEligible) {
 	eligible[0] = true;
 	Sampling::updateEligible(*p, order, 0, eligible);
 	TestHelpers::arrayEquals(eligibleExp, eligible);
-}
\ No newline at end of file
+}
+TEST_F(SamplingTest, testRegretBasedBiasedRandomSamplingMatchesDecisionSetProbabilities) {
+	vector<float> prios = { 0.0f, 8.0f, 0.0f, 2.0f, 0.0f };
+	vector<bool> eligs = { false, true, false, true, false };
+	auto probs = Sampling::computeProbsForDecisionSet(eligs, prios);
+
+	const int numSamples = 4000;
+	int numJob1First = 0;
+	for(int i = 0; i < numSamples; i++) {
+		auto order = Sampling::regretBasedBiasedRandomSampling(*p, prios);
+		ASSERT_TRUE(p->isOrderFeasible(order));
+		if (order[1] == 1) numJob1First++;
+	}
+	ASSERT_NEAR(probs[1], static_cast<float>(numJob1First) / numSamples, 0.05f);
+}
+
+TEST(SamplingLargeTest, testSamplersFeasibleOnLargerInstance) {
+	Project p("Data/j3025_4.sm");
+	for(int i = 0; i < 20; i++) {
+		ASSERT_TRUE(p.isOrderFeasible(Sampling::naiveSampling(p)));
+		ASSERT_TRUE(p.isOrderFeasible(Sampling::regretBasedBiasedRandomSamplingForLfts(p)));
+	}
+}
+
+TEST_F(SamplingTest, testPriorityRulesDeterministicOrders) {
+	PriorityRules rules(*p);
+	for(auto rule : PriorityRules::ALL_RULES) {
+		auto order = rules.deterministicOrder(rule);
+		ASSERT_TRUE(p->isOrderFeasible(order));
+		ASSERT_EQ(order, rules.seedOrder(static_cast<int>(rule)));
+	}
+	ASSERT_EQ(static_cast<float>(p->numJobs - 1), rules.priorities(PriorityRules::Rule::MTS)[0]);
+	ASSERT_EQ(0.0f, rules.priorities(PriorityRules::Rule::MTS)[p->lastJob]);
+}
+
+TEST(SamplingLargeTest, testPriorityRulesMultiPassSample) {
+	Project p("Data/j3025_4.sm");
+	PriorityRules rules(p);
+
+	const int numOrders = rules.numRules() * 3;
+	auto orders = rules.multiPassSample(numOrders, 3);
+	ASSERT_EQ(numOrders, orders.size());
+	for(int i = 0; i < numOrders; i++) {
+		ASSERT_TRUE(p.isOrderFeasible(orders[i]));
+		if(i < rules.numRules()) {
+			ASSERT_EQ(rules.deterministicOrder(PriorityRules::ALL_RULES[i]), orders[i]);
+		}
+	}
+}
+
+TEST(SamplingLargeTest, testPriorityRulesMultiPassSampleIndependentOfThreadCount) {
+	Project p("Data/j3025_4.sm");
+	PriorityRules rules(p);
+
+	const int numOrders = rules.numRules() * 3;
+	Utils::seedRandomEngine(17);
+	const auto sequential = rules.multiPassSample(numOrders, 1);
+	const unsigned int nextSequential = Utils::randomEngine()();
+	Utils::seedRandomEngine(17);
+	const auto parallel = rules.multiPassSample(numOrders, 4);
+	ASSERT_EQ(sequential, parallel);
+	ASSERT_EQ(nextSequential, Utils::randomEngine()());
+}
@@ -0,0 +1,29 @@
+#include <gtest/gtest.h>
+#include "../GeneticAlgorithms/Surrogate.h"
+
+using namespace std;
+
+TEST(SurrogateTest, testRidgeRegressionRecoversLinearFunction) {
+	Surrogate::RidgeRegression model(2, 0.0001f);
+	for(int i = 0; i < 50; i++) {
+		const float x1 = static_cast<float>(i % 7), x2 = static_cast<float>(i % 5);
+		model.addSample({ x1, x2 }, 3.0f * x1 - 2.0f * x2 + 5.0f);
+	}
+	model.fit();
+	ASSERT_EQ(50, model.getNumSamples());
+	ASSERT_NEAR(5.0f, model.predict({ 0.0f, 0.0f }), 0.01f);
+	ASSERT_NEAR(3.0f * 10.0f - 2.0f * 3.0f + 5.0f, model.predict({ 10.0f, 3.0f }), 0.05f);
+}
+
+TEST(SurrogateTest, testRankFeatures) {
+	vector<float> ranks = Surrogate::rankFeatures({ 0, 2, 1, 3 });
+	vector<float> expRanks = { 0.0f, 0.5f, 0.25f, 0.75f };
+	ASSERT_EQ(expRanks, ranks);
+}
+
+TEST(SurrogateTest, testFeaturesForLambdaZr) {
+	ProjectWithOvertime p("Data/MiniBeispiel.DAT");
+	LambdaZr indiv(p.topOrder, vector<int>(static_cast<size_t>(p.numRes), 0));
+	auto x = Surrogate::features(p, indiv);
+	ASSERT_EQ(p.numJobs + p.numRes, x.size());
+}
@@ -6,10 +6,16 @@
 
 #include <vector>
 #include <list>
+#include <memory>
+#include <string>
 
 #include <gtest/gtest.h>
+#include <boost/filesystem.hpp>
 
 #include "../Matrix.h"
+#include "../InstanceGenerator.h"
+#include "../ProjectWithOvertime.h"
+#include "../ScopedTempWorkingDirectory.h"
 
 class TestHelpers {
 public:
@@ -46,4 +52,23 @@ public:
 			for (int j = 0; j < actual.getN(); j++)
 				ASSERT_EQ(expected(i, j), actual(i, j)) << "i=" << i << ",j=" << j << std::endl;
     }
+
+	static std::unique_ptr<ProjectWithOvertime> generatedInstance(int numJobs, int numRes, float resourceStrength, int seed) {
+		InstanceGenerator::GeneratorParameters params;
+		params.numJobs = numJobs;
+		params.numRes = numRes;
+		params.resourceStrength = resourceStrength;
+		params.seed = seed;
+		return std::make_unique<ProjectWithOvertime>("generated" + std::to_string(seed), InstanceGenerator::generateSmContents(params));
+	}
+
+	// Eight jobs with scarce capacities, solved exactly by branch and bound in milliseconds
+	static std::unique_ptr<ProjectWithOvertime> smallInstance(int seed) {
+		InstanceGenerator::GeneratorParameters params;
+		params.numJobs = 8;
+		params.resourceStrength = 0.2f;
+		params.seed = seed;
+		return std::make_unique<ProjectWithOvertime>("small" + std::to_string(seed), InstanceGenerator::generateSmContents(params));
+	}
 };
+
@@ -3,9 +3,12 @@
 //
 
 #include "../Utils.h"
+#include "../Logger.h"
+#include "../AsyncSink.h"
 #include "TestHelpers.h"
 #include <gtest/gtest.h>
 #include <cstdio>
+#include <thread>
 #include <boost/algorithm/string.hpp>
 #include <boost/filesystem.hpp>
 
@@ -390,3 +393,87 @@ TEST(UtilsTest, testTransitiveClosure) {
 		TestHelpers::matrixEquals(outMx, Utils::transitiveClosure(inMx));
 	}
 }
+
+TEST(UtilsTest, testTracerRecordsFromMultipleThreads) {
+	const string prefix = "TracerTestTrace";
+	{
+		Utils::Tracer tr(prefix, Utils::Tracer::TraceMode::ONLY_COUNT);
+		vector<thread> workers;
+		for(int tix = 0; tix < 4; tix++) {
+			workers.emplace_back([&tr, tix] {
+				for(int i = 1; i <= 10000; i++)
+					tr.countTrace(static_cast<float>(tix), i, i);
+			});
+		}
+		for(auto &worker : workers)
+			worker.join();
+		tr.trace(2000.0, 42.0f, 3, 4);
+		tr.flush();
+
+		auto lines = Utils::readLines(prefix + ".txt");
+		ASSERT_EQ("slvtime,bks_objval,nschedules,nindividuals", lines[0]);
+		ASSERT_EQ("0.00,0,0,0", lines[1]);
+		ASSERT_TRUE(any_of(lines.begin(), lines.end(), [](const string &line) { return line == "2.00,42,3,4"; }));
+	}
+	std::remove((prefix + ".txt").c_str());
+}
+
+TEST(UtilsTest, testAsyncSinkKeepsOneRingPerThreadAndSink) {
+	vector<int> consumed[2];
+	Utils::AsyncSink<int> first([&](vector<int> &batch) { consumed[0].insert(consumed[0].end(), batch.begin(), batch.end()); }, [] {}, 8);
+	Utils::AsyncSink<int> second([&](vector<int> &batch) { consumed[1].insert(consumed[1].end(), batch.begin(), batch.end()); }, [] {}, 8);
+
+	for(int i = 0; i < 100; i++) {
+		first.push(i);
+		second.push(-i);
+	}
+	{
+		Utils::AsyncSink<int> shortLived([](vector<int> &) {}, [] {});
+		shortLived.push(1);
+	}
+	first.push(100);
+	// rings of exited threads are dropped once drained
+	for(int tix = 0; tix < 10; tix++)
+		thread([&] { first.push(101); }).join();
+	first.flush();
+	second.flush();
+
+	ASSERT_EQ(1, first.numRings());
+	ASSERT_EQ(1, second.numRings());
+	ASSERT_EQ(111, consumed[0].size());
+	ASSERT_EQ(100, consumed[1].size());
+	for(int i = 0; i < 100; i++) {
+		ASSERT_EQ(i, consumed[0][i]);
+		ASSERT_EQ(-i, consumed[1][i]);
+	}
+}
+
+TEST(UtilsTest, testLoggerSkipsDisabledLevelsAndWritesAsync) {
+	const string name = "LoggerTest";
+	ScopedTempWorkingDirectory tempDir;
+	{
+		Utils::Logger quiet(name + "Quiet", Utils::Logger::LogMode::QUIET);
+		ASSERT_FALSE(quiet.isEnabled(Utils::Logger::LogLevel::ERROR));
+		Utils::Logger medium(name + "Medium", Utils::Logger::LogMode::MEDIUM);
+		ASSERT_FALSE(medium.isEnabled(Utils::Logger::LogLevel::INFO));
+		ASSERT_TRUE(medium.isEnabled(Utils::Logger::LogLevel::WARNING));
+		// errors are on disk as soon as log returns
+		medium.log(Utils::Logger::LogLevel::ERROR, "failed");
+		ASSERT_TRUE(contains(Utils::slurp(name + "MediumLog.txt"), "]: failed"));
+
+		Utils::Logger verbose(name, Utils::Logger::LogMode::VERBOSE);
+		vector<thread> workers;
+		for(int tix = 0; tix < 4; tix++) {
+			workers.emplace_back([&verbose, tix] {
+				for(int i = 0; i < 100; i++)
+					verbose.log(Utils::Logger::LogLevel::INFO, "msg" + to_string(tix));
+			});
+		}
+		for(auto &worker : workers)
+			worker.join();
+		verbose.flush();
+
+		auto lines = Utils::readLines(name + "Log.txt");
+		ASSERT_EQ(400, count_if(lines.begin(), lines.end(), [](const string &line) { return contains(line, "]: msg"); }));
+	}
+}
@@ -0,0 +1,53 @@
+#include <cstring>
+#include <stdexcept>
+#include <boost/filesystem.hpp>
+
+#include "Checkpoint.h"
+
+using namespace std;
+
+namespace {
+	const char MAGIC[4] = { 'C', 'K', 'P', 'T' };
+}
+
+namespace Checkpoint {
+	Writer::Writer(const string &_filename, uint32_t version)
+		: filename(_filename), tmpFilename(_filename + ".tmp"), out(tmpFilename, ios::binary | ios::trunc) {
+		if(!out)
+			throw runtime_error("Unable to write checkpoint " + tmpFilename);
+		out.write(MAGIC, sizeof(MAGIC));
+		put(version);
+	}
+
+	void Writer::putString(const string &s) {
+		put<uint64_t>(s.size());
+		out.write(s.data(), s.size());
+	}
+
+	void Writer::commit() {
+		out.close();
+		if(!out)
+			throw runtime_error("Unable to write checkpoint " + tmpFilename);
+		boost::filesystem::rename(tmpFilename, filename);
+	}
+
+	Reader::Reader(const string &_filename, uint32_t version) : filename(_filename), in(_filename, ios::binary) {
+		char magic[sizeof(MAGIC)];
+		in.read(magic, sizeof(magic));
+		check();
+		if(memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 || get<uint32_t>() != version)
+			throw runtime_error("No checkpoint of version " + to_string(version) + ": " + filename);
+	}
+
+	string Reader::getString() {
+		string s(static_cast<size_t>(get<uint64_t>()), '\0');
+		in.read(&s[0], s.size());
+		check();
+		return s;
+	}
+
+	void Reader::check() const {
+		if(!in)
+			throw runtime_error("Truncated checkpoint " + filename);
+	}
+}
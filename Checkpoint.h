@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Binary checkpoint files of long running searches. The writer replaces the file atomically on commit,
+// so a process killed while writing leaves the previous checkpoint intact.
+namespace Checkpoint {
+	class Writer {
+	public:
+		Writer(const std::string &_filename, uint32_t version);
+
+		template<class T>
+		void put(const T &value) {
+			static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable values are written as raw bytes");
+			out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+		}
+
+		template<class T>
+		void putVector(const std::vector<T> &values) {
+			put<uint64_t>(values.size());
+			for(const T &value : values)
+				put(value);
+		}
+
+		void putString(const std::string &s);
+		void commit();
+
+	private:
+		std::string filename, tmpFilename;
+		std::ofstream out;
+	};
+
+	class Reader {
+	public:
+		// Throws if the file is no checkpoint of the given version
+		Reader(const std::string &_filename, uint32_t version);
+
+		template<class T>
+		T get() {
+			static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable values are read as raw bytes");
+			T value;
+			in.read(reinterpret_cast<char *>(&value), sizeof(T));
+			check();
+			return value;
+		}
+
+		template<class T>
+		std::vector<T> getVector() {
+			std::vector<T> values(static_cast<size_t>(get<uint64_t>()));
+			for(T &value : values)
+				value = get<T>();
+			return values;
+		}
+
+		std::string getString();
+
+	private:
+		std::string filename;
+		std::ifstream in;
+
+		void check() const;
+	};
+}
@@ -16,7 +16,7 @@ FixedDeadlineGA::FixedDeadlineGA(ProjectWithOvertime &_p): GeneticAlgorithm(_p,
 DeadlineLambda FixedDeadlineGA::init(int ix) {
     DeadlineLambda indiv(p.numJobs);
 	indiv.deadlineOffset = (ix == 0) ? deadlineOffsetUB : Utils::randRangeIncl(deadlineOffsetLB, deadlineOffsetUB);
-    indiv.order = ix == 0 ? p.topOrder : Sampling::sample(params.rbbrs, p);
+    indiv.order = initialOrder(ix);
     return indiv;
 }
 
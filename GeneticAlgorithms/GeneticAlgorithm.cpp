@@ -23,7 +23,15 @@ GAParameters::GAParameters() :
 		rbbrs(false),
 		enforceTopOrdering(true),
 		fbiFeedbackInjection(false),
-		partitionSize(4) {
+		partitionSize(4),
+		steadyState(false),
+		sgsCheckpoints(0),
+		sgsCheckpointMemoryLimit(256),
+		priorityRuleSeeding(false),
+		fitnessPrescreen(false),
+		surrogateBatchFactor(1),
+		stopAtProfitBound(false),
+		lagrangianIterations(0) {
 }
 
 void GAParameters::from_json(const json11::Json &obj) {
@@ -32,7 +40,12 @@ void GAParameters::from_json(const json11::Json &obj) {
 			{"popSize", &popSize},
 			{"pmutate", &pmutate},
 			{"iterLimit", &iterLimit},
-			{"partitionSize", &partitionSize}
+			{"partitionSize", &partitionSize},
+			{"threadCount", &threadCount},
+			{"sgsCheckpoints", &sgsCheckpoints},
+			{"sgsCheckpointMemoryLimit", &sgsCheckpointMemoryLimit},
+			{"surrogateBatchFactor", &surrogateBatchFactor},
+			{"lagrangianIterations", &lagrangianIterations}
 	};
 
 	const std::map<std::string, double *> keyNamesToDoubleSlots = {
@@ -43,7 +56,11 @@ void GAParameters::from_json(const json11::Json &obj) {
 			{"fitnessBasedPairing", &fitnessBasedPairing},
 			{"enforceTopOrdering", &enforceTopOrdering},
 			{"rbbrs", &rbbrs},
-			{"fbiFeedbackInjection", &fbiFeedbackInjection}
+			{"fbiFeedbackInjection", &fbiFeedbackInjection},
+			{"steadyState", &steadyState},
+			{"priorityRuleSeeding", &priorityRuleSeeding},
+			{"fitnessPrescreen", &fitnessPrescreen},
+			{"stopAtProfitBound", &stopAtProfitBound}
 	};
 
 	JsonUtils::assignNumberSlotsFromJsonWithMapping<int>(obj, keyNamesToIntSlots);
@@ -80,6 +97,14 @@ json11::Json GAParameters::to_json() const {
 			{"threadCount", threadCount},
 			{"timeLimit", timeLimit},
 			{"traceobj", traceobj},
-			{"partitionSize", partitionSize}
+			{"partitionSize", partitionSize},
+			{"steadyState", steadyState},
+			{"sgsCheckpoints", sgsCheckpoints},
+			{"sgsCheckpointMemoryLimit", sgsCheckpointMemoryLimit},
+			{"priorityRuleSeeding", priorityRuleSeeding},
+			{"fitnessPrescreen", fitnessPrescreen},
+			{"surrogateBatchFactor", surrogateBatchFactor},
+			{"stopAtProfitBound", stopAtProfitBound},
+			{"lagrangianIterations", lagrangianIterations}
 	};
 }
@@ -9,14 +9,22 @@
 #include <algorithm>
 #include <iostream>
 #include <thread>
+#include <mutex>
+#include <atomic>
 #include <boost/format.hpp>
 #include <boost/algorithm/string.hpp>
 #include <boost/filesystem/operations.hpp>
 
 #include "../ProjectWithOvertime.h"
+#include "../Bounds.h"
+#include "../LagrangianRelaxation.h"
 #include "../Stopwatch.h"
 #include "../BasicSolverParameters.h"
 #include "../Logger.h"
+#include "../Instrumentation.h"
+#include "PriorityRules.h"
+#include "Sampling.h"
+#include "Surrogate.h"
 
 const bool FORCE_SINGLE_THREAD = true;
 
@@ -56,11 +64,79 @@ struct GAParameters : BasicSolverParameters, JsonUtils::IJsonSerializable {
 	ScheduleGenerationScheme sgs;
 	bool rbbrs, enforceTopOrdering, fbiFeedbackInjection;
 	int partitionSize;
+	bool steadyState;
+	// Number of SGS checkpoints kept per (lambda|zr) or (lambda|zrt) individual, each holding numJobs + numRes * numPeriods ints
+	int sgsCheckpoints;
+	// Megabytes all individuals together may spend on SGS checkpoints, lowers the number of checkpoints per individual to fit
+	int sgsCheckpointMemoryLimit;
+	bool priorityRuleSeeding;
+	// Skip the forward-backward improvement of children whose profit bound cannot enter the population, ignored with duel selection
+	bool fitnessPrescreen;
+	// Candidate children per population slot ranked by the surrogate model, 1 disables the surrogate
+	int surrogateBatchFactor;
+	// Stop as soon as the best individual reaches the profit upper bound and is proven optimal
+	bool stopAtProfitBound;
+	// Subgradient iterations of the Lagrangian profit bound whose optimality gap is reported after the run, 0 disables it
+	int lagrangianIterations;
+};
+
+// Individuals are kept in a stable arena, selection only permutes the (arena index, fitness) ranking
+template<class Individual>
+class Population {
+public:
+	explicit Population(int size = 0) : individuals(static_cast<size_t>(size)), ranking(static_cast<size_t>(size)) {
+		for (int i = 0; i < size; i++)
+			ranking[i] = { i, 0.0f };
+	}
+
+	Individual &operator[](int pos) { return individuals[ranking[pos].first]; }
+	const Individual &operator[](int pos) const { return individuals[ranking[pos].first]; }
+
+	float &fitness(int pos) { return ranking[pos].second; }
+	float fitness(int pos) const { return ranking[pos].second; }
+
+	int arenaIndex(int pos) const { return ranking[pos].first; }
+	int size() const { return static_cast<int>(ranking.size()); }
+
+	void swap(int pos1, int pos2) { std::swap(ranking[pos1], ranking[pos2]); }
+
+	// Arena slots outside the ranking, e.g. for candidates that only enter the population when selected
+	void addSpares(int count, Individual prototype) {
+		for (int k = 0; k < count; k++)
+			spares.push_back(static_cast<int>(individuals.size()) + k);
+		individuals.resize(individuals.size() + static_cast<size_t>(count), prototype);
+	}
+
+	Individual &spare(int k) { return individuals[spares[k]]; }
+	int numSpares() const { return static_cast<int>(spares.size()); }
+
+	// Spare k takes ranking position pos, the individual previously there becomes spare k
+	void exchangeWithSpare(int pos, int k) { std::swap(ranking[pos].first, spares[k]); }
+
+	void sortByFitness() {
+		std::sort(ranking.begin(), ranking.end(), [](const std::pair<int, float> &left, const std::pair<int, float> &right) { return left.second < right.second; });
+	}
+
+	void swapBestToFront(int numCandidates) {
+		int posOfBest = 0;
+		for (int i = 1; i < numCandidates; i++) {
+			if (ranking[i].second < ranking[posOfBest].second)
+				posOfBest = i;
+		}
+		swap(0, posOfBest);
+	}
+
+private:
+	std::vector<Individual> individuals;
+	std::vector<std::pair<int, float>> ranking;
+	std::vector<int> spares;
 };
 
 struct FitnessResult {
 	float value;
 	int numSchedulesGenerated;
+	// Value of the unimproved schedule because the prescreen rejected the child
+	bool prescreened = false;
 
 	FitnessResult(float value, int numSchedulesGenerated);
 	FitnessResult(const ProjectWithOvertime &p, const SGSResult &res);
@@ -78,17 +154,28 @@ public:
 
 	std::string getName() const { return name; }
 
+	// Empty unless traceobj is set
+	std::vector<Utils::Tracer::TracePoint> anytimeCurve() const {
+		return tr != nullptr ? tr->anytimeCurve() : std::vector<Utils::Tracer::TracePoint>();
+	}
+
+	// Relative gap between the profit of the last run and its upper bound, negative unless lagrangianIterations is set
+	float getOptimalityGap() const { return optimalityGap; }
+
 protected:
     GAParameters params;
 	ProjectWithOvertime &p;
 
     std::unique_ptr<Utils::Tracer> tr = nullptr;
+	std::unique_ptr<PriorityRules> priorityRules = nullptr;
 
 	// also consider FORCE_SINGLE_THREAD!
     bool useThreads = false;
+	// Decoders sharing solver state between calls are only run by one thread, even with threadCount > 1
+	bool reentrantDecoding = true;
 	const std::string name;
 
-    explicit GeneticAlgorithm(ProjectWithOvertime &_p, const std::string &_name = "GenericGA") : p(_p), tr(nullptr), name(_name) {}
+    explicit GeneticAlgorithm(ProjectWithOvertime &_p, const std::string &_name = "GenericGA") : p(_p), tr(nullptr), name(_name), profitBound(std::numeric_limits<float>::max()), optimalityGap(-1.0f) {}
 
     virtual Individual init(int ix) = 0;
     virtual void crossover(Individual &mother, Individual &father, Individual &daughter) = 0;
@@ -96,19 +183,57 @@ protected:
 
     virtual FitnessResult fitness(Individual &i) = 0;
 	virtual std::vector<int> decode(Individual &i) = 0;
+
+	// Feature vector for the surrogate model, representations without features are never prescreened by it
+	virtual std::vector<float> features(const Individual &) const { return {}; }
 	
     template<class Func>
     void withMutProb(Func code) const;
 
+	std::vector<int> initialOrder(int ix) const;
+
+	// sgsCheckpoints lowered such that the checkpoints of the population and the surrogate candidates fit into sgsCheckpointMemoryLimit
+	int numSgsCheckpoints() const;
+
+	// True if no improvement of a schedule with this makespan can enter the population
+	bool prescreenRejects(int makespan);
+
 private:
-	std::vector<std::pair<Individual, float>> computeInitialPopulation(int popSize, int &scheduleCount, int &indivCount);
-	void generateChildren(std::vector<std::pair<Individual, float>> & population);
+	Population<Individual> computeInitialPopulation(int popSize, int &scheduleCount, int &indivCount);
+	void generateChildren(Population<Individual> &pop);
+	void generateChildrenWithSurrogate(Population<Individual> &pop);
+	void trainSurrogate(const Individual &i, float fitnessValue);
+	FitnessResult timedFitness(Individual &i);
 
+	int numDecodingThreads(int numTasks) const;
 	std::pair<int, int> computePair(const std::vector<bool> &alreadySelected) const;
-	std::pair<int, int> mutateAndFitnessRange(std::vector<std::pair<Individual, float>> *pop, int startIx, int endIx);
+	std::pair<int, int> mutateAndFitnessRange(Population<Individual> *pop, int startIx, int endIx);
+
+	void selectBest(Population<Individual> &pop);
+	void selectDuel(Population<Individual> &pop);
+
+	double evolveSteadyState(Population<Individual> &pop, int &scheduleCount, int &indivCount, const Stopwatch &sw);
+	void steadyStateWorker(Population<Individual> &pop, int bufferPos, int &scheduleCount, int &indivCount, const Stopwatch &sw, double &lastImprovementTime);
+	int tournament(const Population<Individual> &pop, int excludedPos) const;
+
+	void updateAdmissionProfit(const Population<Individual> &pop);
+	bool reachedProfitBound(const Population<Individual> &pop) const;
+	void reportPrescreenStatistics() const;
+	void reportOptimalityGap(float profit);
 
-	void selectBest(std::vector<std::pair<Individual, float>> &pop);
-	void selectDuel(std::vector<std::pair<Individual, float>> &pop);	
+	// Profit of the worst population member, lowest float while the initial population is computed
+	std::atomic<float> admissionProfit;
+	// Only children replacing the worst member enter the population with BEST selection or steady state, DUEL may admit worse ones
+	bool prescreenEnabled = false;
+	std::vector<float> profitBoundsByMakespan;
+	float profitBound, optimalityGap;
+	std::atomic<int> prescreenChecks, prescreenSkips;
+
+	std::unique_ptr<Surrogate::RidgeRegression> surrogate;
+
+	std::mutex populationMutex;
+	std::vector<std::mutex> slotMutexes;
+	std::atomic<int> steadyStateChildCount;
 };
 
 template<class Individual>
@@ -117,8 +242,75 @@ inline void GeneticAlgorithm<Individual>::withMutProb(Func code) const {
     if(Utils::randRangeIncl(1, 100) <= params.pmutate) { code(); }
 }
 
+template<class Individual>
+std::vector<int> GeneticAlgorithm<Individual>::initialOrder(int ix) const {
+	if(priorityRules != nullptr)
+		return priorityRules->seedOrder(ix);
+	return ix == 0 ? p.topOrder : Sampling::sample(params.rbbrs, p);
+}
+
+template<class Individual>
+bool GeneticAlgorithm<Individual>::prescreenRejects(int makespan) {
+	if(!prescreenEnabled) return false;
+	const float threshold = admissionProfit;
+	if(threshold == std::numeric_limits<float>::lowest())
+		return false;
+
+	prescreenChecks++;
+	if(makespan >= static_cast<int>(profitBoundsByMakespan.size()) || profitBoundsByMakespan[makespan] > threshold)
+		return false;
+
+	prescreenSkips++;
+	return true;
+}
+
+template<class Individual>
+void GeneticAlgorithm<Individual>::updateAdmissionProfit(const Population<Individual> &pop) {
+	float worstFitness = pop.fitness(0);
+	for(int i = 1; i < params.popSize; i++)
+		worstFitness = std::max(worstFitness, pop.fitness(i));
+	admissionProfit = -worstFitness;
+}
+
+template<class Individual>
+bool GeneticAlgorithm<Individual>::reachedProfitBound(const Population<Individual> &pop) const {
+	if(!params.stopAtProfitBound) return false;
+	const float tolerance = 1e-5f * std::max(1.0f, std::fabs(profitBound));
+	return -pop.fitness(0) >= profitBound - tolerance;
+}
+
+template<class Individual>
+void GeneticAlgorithm<Individual>::reportOptimalityGap(float profit) {
+	LagrangianRelaxation relaxation(p);
+	const float upperBound = std::min(Bounds(p).profitUpperBound(), relaxation.profitUpperBound(profit, params.lagrangianIterations));
+	optimalityGap = (upperBound - profit) / std::max(1.0f, std::fabs(upperBound));
+	LOG_I("Profit upper bound " + std::to_string(upperBound) + " after " + std::to_string(relaxation.getIterationCount()) + " subgradient iterations (gap=" + std::to_string(optimalityGap) + ")");
+
+	if(tr != nullptr) {
+		INSTR_TIME(TRACING);
+		const std::string traceFilename = traceFilenameForGeneticAlgorithm(params.outPath, name, p.instanceName);
+		Utils::spit("profit,upperBound,gap\n" + std::to_string(profit) + "," + std::to_string(upperBound) + "," + std::to_string(optimalityGap) + "\n", traceFilename + "_Gap.txt");
+	}
+}
+
+template<class Individual>
+void GeneticAlgorithm<Individual>::reportPrescreenStatistics() const {
+	const int checks = prescreenChecks, skips = prescreenSkips;
+	const float skipRatio = checks > 0 ? static_cast<float>(skips) / static_cast<float>(checks) : 0.0f;
+	LOG_I("Prescreen skipped " + std::to_string(skips) + " of " + std::to_string(checks) + " decodings (ratio=" + std::to_string(skipRatio) + ")");
+
+	if(tr != nullptr) {
+		INSTR_TIME(TRACING);
+		const std::string traceFilename = traceFilenameForGeneticAlgorithm(params.outPath, name, p.instanceName);
+		Utils::spit("checks,skips,ratio\n" + std::to_string(checks) + "," + std::to_string(skips) + "," + std::to_string(skipRatio) + "\n", traceFilename + "_Prescreen.txt");
+	}
+}
+
 template<class Individual>
 GeneticAlgorithm<Individual> *GeneticAlgorithm<Individual>::setParameters(GAParameters _params) {
+	// Surrogate candidates are bred in sibling pairs per batch of popSize
+	if(_params.surrogateBatchFactor > 1 && _params.popSize % 2 != 0)
+		throw std::runtime_error("surrogateBatchFactor > 1 requires an even popSize, got " + std::to_string(_params.popSize));
     params = _params;
     if(params.traceobj && tr == nullptr) {
         tr = std::make_unique<Utils::Tracer>(traceFilenameForGeneticAlgorithm(params.outPath, name, p.instanceName));
@@ -126,6 +318,20 @@ GeneticAlgorithm<Individual> *GeneticAlgorithm<Individual>::setParameters(GAPara
     return this;
 }
 
+template<class Individual>
+int GeneticAlgorithm<Individual>::numDecodingThreads(int numTasks) const {
+	return reentrantDecoding ? std::max(1, std::min(params.threadCount, numTasks)) : 1;
+}
+
+template<class Individual>
+int GeneticAlgorithm<Individual>::numSgsCheckpoints() const {
+	const size_t numIndividuals = static_cast<size_t>(params.popSize) * (1 + std::max(1, params.surrogateBatchFactor));
+	const size_t checkpointBytes = sizeof(int) * (p.numJobs + p.numRes * p.numPeriods);
+	const size_t budgetBytes = static_cast<size_t>(std::max(0, params.sgsCheckpointMemoryLimit)) * 1024 * 1024;
+	const size_t affordable = budgetBytes / std::max<size_t>(1, numIndividuals * checkpointBytes);
+	return static_cast<int>(std::min<size_t>(static_cast<size_t>(std::max(0, params.sgsCheckpoints)), affordable));
+}
+
 template<class Individual>
 std::pair<int, int> GeneticAlgorithm<Individual>::computePair(const std::vector<bool> &alreadySelected) const {
     std::pair<int, int> p;
@@ -141,26 +347,71 @@ std::pair<int, int> GeneticAlgorithm<Individual>::computePair(const std::vector<
 };
 
 template<class Individual>
-void GeneticAlgorithm<Individual>::generateChildren(std::vector<std::pair<Individual, float>> & pop) {
+void GeneticAlgorithm<Individual>::generateChildren(Population<Individual> &pop) {
+	INSTR_TIME(CROSSOVER);
 	std::vector<bool> alreadySelected(params.popSize, false);
 
     for(int childIx=params.popSize; childIx<params.popSize*2; childIx +=2) {
 		std::pair<int, int> parentIndices = computePair(alreadySelected);
         alreadySelected[parentIndices.first] = true;
         alreadySelected[parentIndices.second] = true;
-        crossover(pop[parentIndices.first].first, pop[parentIndices.second].first, pop[childIx].first);
-        crossover(pop[parentIndices.second].first, pop[parentIndices.first].first, pop[childIx+1].first);
+        crossover(pop[parentIndices.first], pop[parentIndices.second], pop[childIx]);
+        crossover(pop[parentIndices.second], pop[parentIndices.first], pop[childIx+1]);
     }
 }
 
+// Breeds surrogateBatchFactor mutated candidates per child slot and keeps the ones with the highest predicted profit
 template<class Individual>
-std::pair<int,int> GeneticAlgorithm<Individual>::mutateAndFitnessRange(std::vector<std::pair<Individual, float>> *pop, int startIx, int endIx) {
-	static FitnessResult fres;
+void GeneticAlgorithm<Individual>::generateChildrenWithSurrogate(Population<Individual> &pop) {
+	const int numCandidates = pop.numSpares();
+	std::vector<std::pair<float, int>> predictions(static_cast<size_t>(numCandidates));
+	std::vector<bool> alreadySelected;
+
+	surrogate->fit();
+
+	for(int c = 0; c < numCandidates; c += 2) {
+		INSTR_TIME(CROSSOVER);
+		if(c % params.popSize == 0)
+			alreadySelected.assign(static_cast<size_t>(params.popSize), false);
+		std::pair<int, int> parentIndices = computePair(alreadySelected);
+		alreadySelected[parentIndices.first] = true;
+		alreadySelected[parentIndices.second] = true;
+		crossover(pop[parentIndices.first], pop[parentIndices.second], pop.spare(c));
+		crossover(pop[parentIndices.second], pop[parentIndices.first], pop.spare(c + 1));
+	}
+
+	for(int c = 0; c < numCandidates; c++) {
+		{
+			INSTR_TIME(MUTATION);
+			mutate(pop.spare(c));
+		}
+		predictions[c] = { -surrogate->predict(features(pop.spare(c))), c };
+	}
+
+	std::partial_sort(predictions.begin(), predictions.begin() + params.popSize, predictions.end());
+	for(int k = 0; k < params.popSize; k++)
+		pop.exchangeWithSpare(params.popSize + k, predictions[k].second);
+}
+
+template<class Individual>
+FitnessResult GeneticAlgorithm<Individual>::timedFitness(Individual &i) {
+	INSTR_TIME(DECODE);
+	return fitness(i);
+}
+
+template<class Individual>
+void GeneticAlgorithm<Individual>::trainSurrogate(const Individual &i, float fitnessValue) {
+	if(surrogate != nullptr)
+		surrogate->addSample(features(i), -fitnessValue);
+}
+
+template<class Individual>
+std::pair<int,int> GeneticAlgorithm<Individual>::mutateAndFitnessRange(Population<Individual> *pop, int startIx, int endIx) {
 	int scheduleCount = 0, indivCount = 0;
     for(int i=startIx; i<=endIx; i++) {
-        mutate((*pop)[i].first);
-		fres = fitness((*pop)[i].first);
-        (*pop)[i].second = -fres.value;
+        mutate((*pop)[i]);
+		FitnessResult fres = fitness((*pop)[i]);
+        pop->fitness(i) = -fres.value;
 		scheduleCount += fres.numSchedulesGenerated;
 		indivCount++;
     }
@@ -168,30 +419,14 @@ std::pair<int,int> GeneticAlgorithm<Individual>::mutateAndFitnessRange(std::vect
 }
 
 template<class Individual>
-void GeneticAlgorithm<Individual>::selectBest(std::vector<std::pair<Individual, float>> &pop) {
-	std::sort(pop.begin(), pop.end(), [](auto &left, auto &right) { return left.second < right.second; });
-}
-
-template<class T>
-void swapIndividuals(std::vector<T> &pop, int ix1, int ix2) {
-	T tmp = pop[ix1];
-	pop[ix1] = pop[ix2];
-	pop[ix2] = pop[ix1];
-}
-
-template<class T>
-void swapBestIndividualToFront(std::vector<T> &pop) {
-	int ixOfBest = 0;
-	for (int i = 1; i < pop.size() / 2; i++) {
-		if (pop[i].second < pop[ixOfBest].second) {
-			ixOfBest = i;
-		}
-	}
-	swapIndividuals(pop, 0, ixOfBest);
+void GeneticAlgorithm<Individual>::selectBest(Population<Individual> &pop) {
+	INSTR_TIME(SELECTION);
+	pop.sortByFitness();
 }
 
 template<class Individual>
-void GeneticAlgorithm<Individual>::selectDuel(std::vector<std::pair<Individual, float>> &pop) {
+void GeneticAlgorithm<Individual>::selectDuel(Population<Individual> &pop) {
+	INSTR_TIME(SELECTION);
 	std::vector<bool> alreadySelected(params.popSize*2, false);
 
 	for (int i = 0; i < params.popSize; i++) {
@@ -203,46 +438,184 @@ void GeneticAlgorithm<Individual>::selectDuel(std::vector<std::pair<Individual,
 			p.second = Utils::randRangeIncl(params.popSize, params.popSize * 2 - 1);
 		} while (alreadySelected[p.second] || p.first == p.second);
 
-		if(pop[p.first].second > pop[p.second].second) {
-			swapIndividuals(pop, p.first, p.second);
+		if(pop.fitness(p.first) > pop.fitness(p.second)) {
+			pop.swap(p.first, p.second);
 		}
 
         alreadySelected[p.first] = true;
         alreadySelected[p.second] = true;
 	}
 
-	swapBestIndividualToFront(pop);
+	pop.swapBestToFront(params.popSize);
+}
+
+template<class Individual>
+int GeneticAlgorithm<Individual>::tournament(const Population<Individual> &pop, int excludedPos) const {
+	int first, second;
+	do {
+		first = Utils::randRangeIncl(0, params.popSize - 1);
+	} while (first == excludedPos);
+	do {
+		second = Utils::randRangeIncl(0, params.popSize - 1);
+	} while (second == excludedPos || second == first);
+	return pop.fitness(first) <= pop.fitness(second) ? first : second;
+}
+
+template<class Individual>
+void GeneticAlgorithm<Individual>::steadyStateWorker(Population<Individual> &pop, int bufferPos, int &scheduleCount, int &indivCount, const Stopwatch &sw, double &lastImprovementTime) {
+	const int childLimit = params.numGens == -1 ? -1 : params.numGens * params.popSize;
+
+	while(true) {
+		int motherPos, fatherPos;
+		{
+			std::lock_guard<std::mutex> lock(populationMutex);
+			if ((params.iterLimit != -1 && scheduleCount > params.iterLimit)
+				|| (params.timeLimit != -1.0 && sw.look() >= params.timeLimit * 1000.0)
+				|| (childLimit != -1 && steadyStateChildCount >= childLimit)
+				|| reachedProfitBound(pop))
+				break;
+			steadyStateChildCount++;
+			motherPos = tournament(pop, -1);
+			fatherPos = tournament(pop, motherPos);
+		}
+
+		// Parents are only locked while the child is assembled, decoding runs without any lock held
+		{
+			INSTR_TIME(CROSSOVER);
+			std::lock(slotMutexes[motherPos], slotMutexes[fatherPos]);
+			std::lock_guard<std::mutex> motherLock(slotMutexes[motherPos], std::adopt_lock);
+			std::lock_guard<std::mutex> fatherLock(slotMutexes[fatherPos], std::adopt_lock);
+			crossover(pop[motherPos], pop[fatherPos], pop[bufferPos]);
+		}
+
+		{
+			INSTR_TIME(MUTATION);
+			mutate(pop[bufferPos]);
+		}
+		FitnessResult fres = timedFitness(pop[bufferPos]);
+		const float childFitness = -fres.value;
+
+		std::lock_guard<std::mutex> lock(populationMutex);
+		pop.fitness(bufferPos) = childFitness;
+		scheduleCount += fres.numSchedulesGenerated;
+		indivCount++;
+
+		int worstPos = 0;
+		for(int i = 1; i < params.popSize; i++) {
+			if (pop.fitness(i) > pop.fitness(worstPos))
+				worstPos = i;
+		}
+
+		// Replace worst by swapping arena indices, the former worst becomes this worker's next child buffer
+		if(childFitness < pop.fitness(worstPos)) {
+			std::lock_guard<std::mutex> slotLock(slotMutexes[worstPos]);
+			pop.swap(worstPos, bufferPos);
+
+			if(childFitness < pop.fitness(0)) {
+				LOG_I("Improvement by " + std::to_string(pop.fitness(0) - childFitness));
+				lastImprovementTime = sw.look();
+				if(worstPos != 0) {
+					std::lock_guard<std::mutex> bestSlotLock(slotMutexes[0]);
+					pop.swap(0, worstPos);
+				}
+			}
+
+			if(prescreenEnabled)
+				updateAdmissionProfit(pop);
+		}
+
+		if (tr != nullptr) {
+			INSTR_TIME(TRACING);
+			tr->countTrace(-pop.fitness(0), scheduleCount, indivCount);
+			tr->intervalTrace(-pop.fitness(0), scheduleCount, indivCount);
+		}
+	}
+}
+
+template<class Individual>
+double GeneticAlgorithm<Individual>::evolveSteadyState(Population<Individual> &pop, int &scheduleCount, int &indivCount, const Stopwatch &sw) {
+	const int numThreads = numDecodingThreads(params.popSize);
+	double lastImprovementTime = sw.look();
+
+	LOG_I("Steady state evolution with " + std::to_string(numThreads) + " threads");
+
+	pop.swapBestToFront(params.popSize);
+	slotMutexes = std::vector<std::mutex>(static_cast<size_t>(params.popSize));
+	steadyStateChildCount = 0;
+
+	std::vector<std::thread> workers;
+	for(int tix = 1; tix < numThreads; tix++) {
+		const unsigned int seed = static_cast<unsigned int>(Utils::randomEngine()());
+		workers.emplace_back([this, &pop, tix, seed, &scheduleCount, &indivCount, &sw, &lastImprovementTime] {
+			Utils::seedRandomEngine(seed);
+			steadyStateWorker(pop, params.popSize + tix, scheduleCount, indivCount, sw, lastImprovementTime);
+		});
+	}
+	steadyStateWorker(pop, params.popSize, scheduleCount, indivCount, sw, lastImprovementTime);
+
+	for(auto &worker : workers)
+		worker.join();
+
+	return lastImprovementTime;
 }
 
 template<class Individual> 
-std::vector<std::pair<Individual, float>> GeneticAlgorithm<Individual>::computeInitialPopulation(int popSize, int &scheduleCount, int &indivCount) {
-	std::vector<std::pair<Individual, float>> pop(popSize*2);
+Population<Individual> GeneticAlgorithm<Individual>::computeInitialPopulation(int popSize, int &scheduleCount, int &indivCount) {
+	Population<Individual> pop(popSize*2);
+	std::vector<FitnessResult> results(static_cast<size_t>(popSize));
+	const int numThreads = numDecodingThreads(popSize);
 
 	LOG_I("Computing initial population");
 
-	for (int i = 0; i<params.popSize * 2; i++) {
-		pop[i].first = init(i);
+	// Individuals are registered in index order, so best tracking and traces match the sequential mode
+	auto registerIndividual = [&](int i) {
+		pop.fitness(i) = -results[i].value;
+		scheduleCount += results[i].numSchedulesGenerated;
+		indivCount++;
 
-		if (i < params.popSize) {
-			FitnessResult fres = fitness(pop[i].first);
-			pop[i].second = -fres.value;
-			scheduleCount += fres.numSchedulesGenerated;
-			indivCount++;
+		if (pop.fitness(i) < pop.fitness(0)) {
+			pop.swap(0, i);
+		}
 
-			if (pop[i].second < pop[0].second) {
-				std::pair<Individual, float> tmpIndiv = pop[0];
-				pop[0] = pop[i];
-				pop[i] = tmpIndiv;
+		if (tr != nullptr && indivCount > 0) {
+			INSTR_TIME(TRACING);
+			tr->countTrace(-pop.fitness(0), scheduleCount, indivCount);
+			tr->intervalTrace(-pop.fitness(0), scheduleCount, indivCount);
+		}
+	};
+
+	auto initRange = [&](int firstIx, bool registerImmediately) {
+		for (int i = firstIx; i < popSize * 2; i += numThreads) {
+			pop[i] = init(i);
+			if (i < popSize) {
+				results[i] = timedFitness(pop[i]);
+				if (registerImmediately)
+					registerIndividual(i);
 			}
-
-			if (tr != nullptr && indivCount > 0) {
-				tr->countTrace(-pop[0].second, scheduleCount, indivCount);
-				tr->intervalTrace(-pop[0].second, scheduleCount, indivCount);
+			else {
+				pop.fitness(i) = 0.0f;
 			}
 		}
-		else {
-			pop[i].second = 0.0f;
+	};
+
+	if (numThreads == 1) {
+		initRange(0, true);
+	}
+	else {
+		std::vector<std::thread> workers;
+		for (int tix = 0; tix < numThreads; tix++) {
+			const unsigned int seed = static_cast<unsigned int>(Utils::randomEngine()());
+			workers.emplace_back([&initRange, tix, seed] {
+				Utils::seedRandomEngine(seed);
+				initRange(tix, false);
+			});
 		}
+
+		for (auto &worker : workers)
+			worker.join();
+
+		for (int i = 0; i < popSize; i++)
+			registerIndividual(i);
 	}
 
 	return pop;
@@ -269,34 +642,79 @@ std::pair<std::vector<int>, float> GeneticAlgorithm<Individual>::solve() {
 
 	LOG_I("Computing with abort criterias: iterLimit=" + std::to_string(params.iterLimit) + ", numGens=" + std::to_string(params.numGens) + ", timeLimit=" + std::to_string(params.timeLimit));
 
+	if(params.priorityRuleSeeding && priorityRules == nullptr)
+		priorityRules = std::make_unique<PriorityRules>(p);
+
+	INSTR_RESET();
+
+	admissionProfit = std::numeric_limits<float>::lowest();
+	prescreenChecks = prescreenSkips = 0;
+	prescreenEnabled = params.fitnessPrescreen && (params.steadyState || params.selectionMethod == SelectionMethod::BEST);
+	if(params.fitnessPrescreen && !prescreenEnabled)
+		LOG_W("Fitness prescreen disabled, duel selection can admit children worse than the whole population");
+	if(prescreenEnabled || params.stopAtProfitBound) {
+		const Bounds bounds(p);
+		if(prescreenEnabled && profitBoundsByMakespan.empty())
+			profitBoundsByMakespan = bounds.profitUpperBounds();
+		profitBound = params.stopAtProfitBound ? bounds.profitUpperBound() : std::numeric_limits<float>::max();
+	}
+
 	int scheduleCount = 0, indivCount = 0;
-	std::vector<std::pair<Individual, float>> pop = computeInitialPopulation(params.popSize, scheduleCount, indivCount);
+	Population<Individual> pop = computeInitialPopulation(params.popSize, scheduleCount, indivCount);
     float lastBestVal = std::numeric_limits<float>::max();
 
 	/*auto iterationLogger = [&](int i) {
 		static TimePoint lupdate = chrono::system_clock::now();		
 		double deltat = chrono::duration<double, milli>(chrono::system_clock::now() - lupdate).count();
 		if ((sw.look() <= 1000.0 && deltat >= MSECS_BETWEEN_TRACES_SHORT) || (sw.look() > 1000.0 && deltat >= MSECS_BETWEEN_TRACES_LONG)) {
-			cout << "Generations = " << (i + 1) << ", Obj = " << -pop[0].second << ", Time = " << (boost::format("%.2f") % (sw.look() / 1000.0)) << endl;
+			cout << "Generations = " << (i + 1) << ", Obj = " << -pop.fitness(0) << ", Time = " << (boost::format("%.2f") % (sw.look() / 1000.0)) << endl;
 			lupdate = chrono::system_clock::now();
-			if(params.traceobj) tr->trace(sw.look(), -pop[0].second);
+			if(params.traceobj) tr->trace(sw.look(), -pop.fitness(0));
 		}
 	};*/
 
 	LOG_I("Initial population generated...");
 
-    for(int i=0;   (params.iterLimit == -1 || scheduleCount <= params.iterLimit)
+	// The surrogate is only used by the generational scheme, which evaluates whole batches of children
+	if(params.surrogateBatchFactor > 1 && !params.steadyState) {
+		const int numFeatures = static_cast<int>(features(pop[0]).size());
+		if(surrogate == nullptr && numFeatures > 0) {
+			surrogate = std::make_unique<Surrogate::RidgeRegression>(numFeatures);
+			for(int i = 0; i < params.popSize; i++)
+				trainSurrogate(pop[i], pop.fitness(i));
+		}
+		// Candidates live in spare arena slots, so ranking them into the population only exchanges indices
+		if(surrogate != nullptr)
+			pop.addSpares(params.popSize * params.surrogateBatchFactor, pop[0]);
+	}
+
+	if(prescreenEnabled)
+		updateAdmissionProfit(pop);
+
+	if(params.steadyState)
+		lastImprovementTime = evolveSteadyState(pop, scheduleCount, indivCount, sw);
+
+    for(int i=0;   !params.steadyState
+				&& (params.iterLimit == -1 || scheduleCount <= params.iterLimit)
 				&& (params.numGens == -1 || i < params.numGens)
-				&& (params.timeLimit == -1.0 || sw.look() < params.timeLimit * 1000.0); i++) {
+				&& (params.timeLimit == -1.0 || sw.look() < params.timeLimit * 1000.0)
+				&& !reachedProfitBound(pop); i++) {
 
 		if (tr != nullptr) {
-			tr->intervalTrace(-pop[0].second, scheduleCount, indivCount);
+			INSTR_TIME(TRACING);
+			tr->intervalTrace(-pop.fitness(0), scheduleCount, indivCount);
 		}
 
 		//iterationLogger(i);
 
-		// Pairing and crossover
-        generateChildren(pop);
+		// Pairing and crossover, surrogate ranked children are already mutated
+		if(surrogate != nullptr)
+			generateChildrenWithSurrogate(pop);
+		else
+			generateChildren(pop);
+
+		if(prescreenEnabled)
+			updateAdmissionProfit(pop);
 
 		// Mutation and fitness computation
         if(useThreads && !FORCE_SINGLE_THREAD) {
@@ -312,13 +730,21 @@ std::pair<std::vector<int>, float> GeneticAlgorithm<Individual>::solve() {
             }
         } else {
             for(int j=params.popSize; j<params.popSize*2; j++) {
-                mutate(pop[j].first);
-				FitnessResult fres = fitness(pop[j].first);
-                pop[j].second = -fres.value;
+				if(surrogate == nullptr) {
+					INSTR_TIME(MUTATION);
+					mutate(pop[j]);
+				}
+				FitnessResult fres = timedFitness(pop[j]);
+                pop.fitness(j) = -fres.value;
+				// Unimproved values of prescreened children would bias the surrogate towards pessimistic predictions
+				if(!fres.prescreened)
+					trainSurrogate(pop[j], pop.fitness(j));
 				scheduleCount += fres.numSchedulesGenerated;
 				indivCount++;
-				if(tr != nullptr)
-					tr->countTrace(-pop[0].second, scheduleCount, indivCount);
+				if(tr != nullptr) {
+					INSTR_TIME(TRACING);
+					tr->countTrace(-pop.fitness(0), scheduleCount, indivCount);
+				}
             }
         }
 
@@ -332,33 +758,44 @@ std::pair<std::vector<int>, float> GeneticAlgorithm<Individual>::solve() {
 			break;
 		}
 
-		//cout << "\rGeneration " << (i + 1) << " Obj=" << -pop[0].second << " Time=" << (boost::format("%.2f") % (sw.look() / 1000.0)) << "       ";
+		//cout << "\rGeneration " << (i + 1) << " Obj=" << -pop.fitness(0) << " Time=" << (boost::format("%.2f") % (sw.look() / 1000.0)) << "       ";
 
 		// Show improvements
-        if(pop[0].second < lastBestVal) {
+        if(pop.fitness(0) < lastBestVal) {
 			if (lastBestVal == std::numeric_limits<float>::max())
-				LOG_I("Initial improvement by " + std::to_string(-pop[0].second));
+				LOG_I("Initial improvement by " + std::to_string(-pop.fitness(0)));
 			else
-				LOG_I("Improvement by " + std::to_string(lastBestVal - pop[0].second));
+				LOG_I("Improvement by " + std::to_string(lastBestVal - pop.fitness(0)));
 
 			if(saveLastImprovementTime)
 				lastImprovementTime = sw.look();
 
 	        /*if(params.traceobj)
-				tr->trace(sw.look(), -pop[0].second, scheduleCount, indivCount);*/
+				tr->trace(sw.look(), -pop.fitness(0), scheduleCount, indivCount);*/
         }
-        lastBestVal = pop[0].second;
+        lastBestVal = pop.fitness(0);
     }
 
 	if (tr != nullptr) {
-		tr->intervalTrace(-pop[0].second, scheduleCount, indivCount);
-		tr->countTrace(-pop[0].second, scheduleCount, indivCount);
+		INSTR_TIME(TRACING);
+		tr->intervalTrace(-pop.fitness(0), scheduleCount, indivCount);
+		tr->countTrace(-pop.fitness(0), scheduleCount, indivCount);
 	}
 
+	if(prescreenEnabled)
+		reportPrescreenStatistics();
+
+	if(reachedProfitBound(pop))
+		LOG_I("Best individual reached the profit upper bound " + std::to_string(profitBound) + " and is optimal");
+
+	if(params.lagrangianIterations > 0)
+		reportOptimalityGap(-pop.fitness(0));
+
+	INSTR_REPORT(traceFilenameForGeneticAlgorithm(params.outPath, name, p.instanceName) + "_Profile.json");
+
 	if(saveLastImprovementTime) {
 		Utils::spitAppend(p.instanceName+";"+std::to_string(lastImprovementTime*0.001)+"\n", getName()+"_TimeAtLastImprovementTime.txt");
 	}
 
-    auto best = pop[0];
-	return std::make_pair(decode(best.first), -best.second);
+	return std::make_pair(decode(pop[0]), -pop.fitness(0));
 }
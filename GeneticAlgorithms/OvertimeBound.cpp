@@ -14,7 +14,7 @@ TimeVaryingCapacityGA::TimeVaryingCapacityGA(ProjectWithOvertime &_p) : GeneticA
 
 LambdaZrt TimeVaryingCapacityGA::init(int ix) {
     LambdaZrt indiv(p.numJobs, p.numRes, p.heuristicMakespanUpperBound());
-	indiv.order = params.enforceTopOrdering ? (ix == 0 ? p.topOrder : Sampling::sample(params.rbbrs, p)) : Sampling::randomPermutation(p.numJobs);
+	indiv.order = params.enforceTopOrdering ? initialOrder(ix) : Sampling::randomPermutation(p.numJobs);
 
 	p.eachResConst([&](int r) {
 		int zr = ix == 0 ? 0 : Utils::randRangeIncl(0, p.zmax[r]);
@@ -48,9 +48,20 @@ FitnessResult TimeVaryingCapacityGA::fitness(LambdaZrt &i) {
 
 	switch(params.sgs) {
 	default:
-	case ScheduleGenerationScheme::SERIAL:
-		res = p.serialSGSWithForwardBackwardImprovement(i.order, i.z, !params.enforceTopOrdering);
+	case ScheduleGenerationScheme::SERIAL: {
+		const int numCheckpoints = numSgsCheckpoints();
+		res = numCheckpoints > 0 && params.enforceTopOrdering
+			? p.serialSGSWithCheckpoints(i.order, i.z, i.checkpoints, numCheckpoints)
+			: p.serialSGS(i.order, i.z, !params.enforceTopOrdering);
+		// Improvement increases neither makespan nor costs, so the unimproved schedule is a valid fitness for skipped children
+		if(prescreenRejects(p.makespan(res))) {
+			FitnessResult unimproved(p, res);
+			unimproved.prescreened = true;
+			return unimproved;
+		}
+		res = p.forwardBackwardIterations(i.order, res, p.makespan(res), boost::optional<int>(), !params.enforceTopOrdering);
 		break;
+	}
 	case ScheduleGenerationScheme::PARALLEL:
 		res = p.parallelSGSWithForwardBackwardImprovement(i.order, i.z);		
 		break;
@@ -73,6 +84,10 @@ vector<int> TimeVaryingCapacityGA::decode(LambdaZrt& i) {
 	}
 }
 
+vector<float> TimeVaryingCapacityGA::features(const LambdaZrt &i) const {
+	return Surrogate::features(p, i);
+}
+
 void TimeVaryingCapacityGA::mutateOvertime(Matrix<int>& z) const {
 	p.eachResConst([&](int r) {
 		int zOffset = Utils::randBool() ? 1 : -1;
@@ -92,7 +107,7 @@ FixedCapacityGA::FixedCapacityGA(ProjectWithOvertime &_p) : GeneticAlgorithm(_p,
 
 LambdaZr FixedCapacityGA::init(int ix) {
     LambdaZr indiv(p.numJobs, p.numRes);
-    indiv.order = ix == 0 ? p.topOrder : Sampling::sample(params.rbbrs, p);
+    indiv.order = initialOrder(ix);
     p.eachRes([&](int r){ indiv.z[r] = ix == 0 ? 0 : Utils::randRangeIncl(0, p.zmax[r]); });
     return indiv;
 }
@@ -110,9 +125,20 @@ FitnessResult FixedCapacityGA::fitness(LambdaZr &i) {
 	SGSResult res;
 	switch (params.sgs) {
 	default:
-	case ScheduleGenerationScheme::SERIAL:
-		res = p.serialSGSWithForwardBackwardImprovement(i.order, i.z, !params.enforceTopOrdering);
+	case ScheduleGenerationScheme::SERIAL: {
+		const int numCheckpoints = numSgsCheckpoints();
+		res = numCheckpoints > 0 && params.enforceTopOrdering
+			? p.serialSGSWithCheckpoints(i.order, i.z, i.checkpoints, numCheckpoints)
+			: p.serialSGS(i.order, i.z, !params.enforceTopOrdering);
+		// Improvement increases neither makespan nor costs, so the unimproved schedule is a valid fitness for skipped children
+		if(prescreenRejects(p.makespan(res))) {
+			FitnessResult unimproved(p, res);
+			unimproved.prescreened = true;
+			return unimproved;
+		}
+		res = p.forwardBackwardIterations(i.order, res, p.makespan(res), boost::optional<int>(), !params.enforceTopOrdering);
 		break;
+	}
 	case ScheduleGenerationScheme::PARALLEL:
 		res = p.parallelSGSWithForwardBackwardImprovement(i.order, i.z);
 		break;
@@ -130,6 +156,10 @@ vector<int> FixedCapacityGA::decode(LambdaZr& i) {
 	}
 }
 
+vector<float> FixedCapacityGA::features(const LambdaZr &i) const {
+	return Surrogate::features(p, i);
+}
+
 void FixedCapacityGA::mutateOvertime(vector<int> &z) {
     p.eachRes([&](int r) {
         withMutProb([&]{
@@ -148,7 +178,8 @@ TimeVaryingCapacityRandomKeyGA::TimeVaryingCapacityRandomKeyGA(ProjectWithOverti
 
 RandomKeyZrt TimeVaryingCapacityRandomKeyGA::init(int ix) {
 	RandomKeyZrt indiv(p.numJobs, p.numRes, p.heuristicMakespanUpperBound());
-	indiv.priorities = params.rbbrs ? p.activityListToRandomKey(Sampling::sample(true, p)) : Sampling::randomUnitFloats(p.numJobs);
+	indiv.priorities = params.priorityRuleSeeding ? p.activityListToRandomKey(initialOrder(ix))
+		: (params.rbbrs ? p.activityListToRandomKey(Sampling::sample(true, p)) : Sampling::randomUnitFloats(p.numJobs));
 
 	p.eachResConst([&](int r) {
 		int zr = ix == 0 ? 0 : Utils::randRangeIncl(0, p.zmax[r]);
@@ -184,7 +215,8 @@ FixedCapacityRandomKeyGA::FixedCapacityRandomKeyGA(ProjectWithOvertime &_p) : Ge
 
 RandomKeyZr FixedCapacityRandomKeyGA::init(int ix) {
 	RandomKeyZr indiv(p.numJobs, p.numRes);
-	indiv.priorities = params.rbbrs ? p.activityListToRandomKey(Sampling::sample(true, p)) : Sampling::randomUnitFloats(p.numJobs);
+	indiv.priorities = params.priorityRuleSeeding ? p.activityListToRandomKey(initialOrder(ix))
+		: (params.rbbrs ? p.activityListToRandomKey(Sampling::sample(true, p)) : Sampling::randomUnitFloats(p.numJobs));
 	p.eachRes([&](int r) { indiv.z[r] = ix == 0 ? 0 : Utils::randRangeIncl(0, p.zmax[r]); });
 	return indiv;
 }
@@ -16,6 +16,7 @@ private:
 	void mutate(LambdaZrt &i) override;
     FitnessResult fitness(LambdaZrt &i) override;
 	std::vector<int> decode(LambdaZrt& i) override;
+	std::vector<float> features(const LambdaZrt &i) const override;
 
 	void mutateOvertime(Matrix<int> &z) const;
 };
@@ -29,6 +30,7 @@ private:
 	void mutate(LambdaZr &i) override;
     FitnessResult fitness(LambdaZr &i) override;
 	std::vector<int> decode(LambdaZr& i) override;
+	std::vector<float> features(const LambdaZr &i) const override;
 
 	void mutateOvertime(std::vector<int> &z);
 };
@@ -9,11 +9,13 @@ using namespace std;
 
 PartitionListGA::PartitionListGA(ProjectWithOvertime &_p) : GeneticAlgorithm(_p, "PartitionListGA") {
 	useThreads = false;
+	// the subproject solvers of the decoder are shared between calls
+	reentrantDecoding = false;
 }
 
 PartitionList PartitionListGA::init(int ix) {
 	PartitionList indiv(p.numJobs);
-	indiv.plist = p.orderInducedPartitionsToPartitionList(Sampling::sample(params.rbbrs, p), params.partitionSize);
+	indiv.plist = p.orderInducedPartitionsToPartitionList(params.priorityRuleSeeding ? initialOrder(ix) : Sampling::sample(params.rbbrs, p), params.partitionSize);
 	return indiv;
 }
 
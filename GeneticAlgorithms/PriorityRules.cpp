@@ -0,0 +1,131 @@
+#include <algorithm>
+#include <queue>
+#include <thread>
+#include <boost/dynamic_bitset.hpp>
+
+#include "PriorityRules.h"
+#include "Sampling.h"
+
+using namespace std;
+
+const vector<PriorityRules::Rule> PriorityRules::ALL_RULES = {
+	Rule::LFT, Rule::LST, Rule::MSLK, Rule::MTS, Rule::GRPW, Rule::WRUP, Rule::GRD, Rule::SPT
+};
+
+PriorityRules::PriorityRules(const Project &_p) : p(_p), ruleToPriorities(ALL_RULES.size(), vector<float>(static_cast<size_t>(_p.numJobs))) {
+	const vector<int> totalSuccessors = numTotalSuccessors();
+
+	for(int j = 0; j < p.numJobs; j++) {
+		float relativeDemand = 0.0f, demandSum = 0.0f;
+		for(int r = 0; r < p.numRes; r++) {
+			demandSum += static_cast<float>(p.demands(j, r));
+			if(p.capacities[r] > 0)
+				relativeDemand += static_cast<float>(p.demands(j, r)) / static_cast<float>(p.capacities[r]);
+		}
+
+		int succDurationSum = 0;
+		for(int succ : p.succs[j])
+			succDurationSum += p.durations[succ];
+
+		ruleToPriorities[static_cast<int>(Rule::LFT)][j] = -static_cast<float>(p.lfts[j]);
+		ruleToPriorities[static_cast<int>(Rule::LST)][j] = -static_cast<float>(p.lsts[j]);
+		ruleToPriorities[static_cast<int>(Rule::MSLK)][j] = -static_cast<float>(p.lsts[j] - p.ests[j]);
+		ruleToPriorities[static_cast<int>(Rule::MTS)][j] = static_cast<float>(totalSuccessors[j]);
+		ruleToPriorities[static_cast<int>(Rule::GRPW)][j] = static_cast<float>(p.durations[j] + succDurationSum);
+		ruleToPriorities[static_cast<int>(Rule::WRUP)][j] = 0.7f * static_cast<float>(p.succs[j].size()) + 0.3f * relativeDemand;
+		ruleToPriorities[static_cast<int>(Rule::GRD)][j] = static_cast<float>(p.durations[j]) * demandSum;
+		ruleToPriorities[static_cast<int>(Rule::SPT)][j] = -static_cast<float>(p.durations[j]);
+	}
+}
+
+string PriorityRules::ruleName(Rule rule) {
+	static const vector<string> names = { "LFT", "LST", "MSLK", "MTS", "GRPW", "WRUP", "GRD", "SPT" };
+	return names[static_cast<int>(rule)];
+}
+
+const vector<float> &PriorityRules::priorities(Rule rule) const {
+	return ruleToPriorities[static_cast<int>(rule)];
+}
+
+vector<int> PriorityRules::numTotalSuccessors() const {
+	vector<boost::dynamic_bitset<>> reachable(static_cast<size_t>(p.numJobs), boost::dynamic_bitset<>(static_cast<size_t>(p.numJobs)));
+	vector<int> counts(static_cast<size_t>(p.numJobs));
+
+	for(auto it = p.topOrder.rbegin(); it != p.topOrder.rend(); ++it) {
+		const int j = *it;
+		for(int succ : p.succs[j]) {
+			reachable[j].set(static_cast<size_t>(succ));
+			reachable[j] |= reachable[succ];
+		}
+		counts[j] = static_cast<int>(reachable[j].count());
+	}
+
+	return counts;
+}
+
+vector<int> PriorityRules::deterministicOrder(Rule rule) const {
+	const vector<float> &prios = priorities(rule);
+	auto lowerPriority = [&prios](int i, int j) { return prios[i] < prios[j] || (prios[i] == prios[j] && i > j); };
+	priority_queue<int, vector<int>, decltype(lowerPriority)> eligible(lowerPriority);
+	vector<int> order, numUnscheduledPreds(static_cast<size_t>(p.numJobs));
+	order.reserve(static_cast<size_t>(p.numJobs));
+
+	for(int j = 0; j < p.numJobs; j++) {
+		numUnscheduledPreds[j] = static_cast<int>(p.preds[j].size());
+		if(numUnscheduledPreds[j] == 0)
+			eligible.push(j);
+	}
+
+	while(!eligible.empty()) {
+		const int job = eligible.top();
+		eligible.pop();
+		order.push_back(job);
+
+		for(int succ : p.succs[job]) {
+			if(--numUnscheduledPreds[succ] == 0)
+				eligible.push(succ);
+		}
+	}
+
+	return order;
+}
+
+vector<int> PriorityRules::biasedOrder(Rule rule) const {
+	return Sampling::regretBasedBiasedRandomSampling(p, priorities(rule));
+}
+
+vector<int> PriorityRules::seedOrder(int ix) const {
+	const Rule rule = ALL_RULES[ix % numRules()];
+	return ix < numRules() ? deterministicOrder(rule) : biasedOrder(rule);
+}
+
+vector<vector<int>> PriorityRules::multiPassSample(int numOrders, int threadCount) const {
+	vector<vector<int>> orders(static_cast<size_t>(numOrders));
+	const int numThreads = max(1, min(threadCount, numOrders));
+	// each order is sampled from its own seed, so the orders do not depend on the number of threads
+	const unsigned int baseSeed = static_cast<unsigned int>(Utils::randomEngine()());
+
+	auto sampleRange = [&](int firstIx) {
+		for(int i = firstIx; i < numOrders; i += numThreads) {
+			Utils::seedRandomEngine(baseSeed + static_cast<unsigned int>(i));
+			orders[i] = seedOrder(i);
+		}
+	};
+
+	if(numThreads == 1) {
+		// keep the stream of the calling thread as if the orders were sampled by other threads
+		const mt19937 callerEngine = Utils::randomEngine();
+		sampleRange(0);
+		Utils::randomEngine() = callerEngine;
+		return orders;
+	}
+
+	vector<thread> workers;
+	for(int tix = 0; tix < numThreads; tix++)
+		workers.emplace_back([&sampleRange, tix] { sampleRange(tix); });
+
+	for(auto &worker : workers)
+		worker.join();
+
+	return orders;
+}
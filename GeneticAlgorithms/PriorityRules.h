@@ -0,0 +1,48 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "../Project.h"
+
+// Classic priority rules computed once per instance. All priority values are oriented so that a larger value means
+// a higher priority, which is what the regret based biased random sampling expects.
+class PriorityRules {
+public:
+	enum class Rule {
+		LFT,	// latest finishing time
+		LST,	// latest starting time
+		MSLK,	// minimum slack
+		MTS,	// most total successors
+		GRPW,	// greatest rank positional weight
+		WRUP,	// weighted resource utilization and precedence
+		GRD,	// greatest resource demand
+		SPT		// shortest processing time
+	};
+
+	static const std::vector<Rule> ALL_RULES;
+
+	explicit PriorityRules(const Project &_p);
+
+	int numRules() const { return static_cast<int>(ALL_RULES.size()); }
+	static std::string ruleName(Rule rule);
+
+	const std::vector<float> &priorities(Rule rule) const;
+
+	// Serial list built by always picking the eligible job with the highest priority (lowest index on ties)
+	std::vector<int> deterministicOrder(Rule rule) const;
+	std::vector<int> biasedOrder(Rule rule) const;
+
+	// The first numRules seeds are the deterministic rule orders, all further seeds are biased samples cycling through the rules
+	std::vector<int> seedOrder(int ix) const;
+
+	// Multi pass sampling distributed round robin over threadCount threads. Order i is sampled from a seed derived from
+	// one draw of the caller's random stream and i, so the result does not depend on threadCount.
+	std::vector<std::vector<int>> multiPassSample(int numOrders, int threadCount) const;
+
+private:
+	const Project &p;
+	std::vector<std::vector<float>> ruleToPriorities;
+
+	std::vector<int> numTotalSuccessors() const;
+};
@@ -3,11 +3,25 @@
 //
 
 #include <cmath>
+#include <numeric>
 #include <boost/algorithm/clamp.hpp>
 #include "Representations.h"
 
 using namespace std;
 
+GeneSet &GeneSet::forThread(int numValues) {
+	thread_local GeneSet geneSet;
+	if(geneSet.stamps.size() < numValues)
+		geneSet.stamps.resize(static_cast<size_t>(numValues), 0);
+	if(++geneSet.generation == 0) {
+		fill(geneSet.stamps.begin(), geneSet.stamps.end(), 0);
+		geneSet.generation = 1;
+	}
+	return geneSet;
+}
+
+//======================================================================================================================
+
 Lambda::Lambda(int numJobs) : order(numJobs) {}
 
 Lambda::Lambda(const vector<int> &_order) : order(_order) {}
@@ -28,10 +42,16 @@ void Lambda::randomOnePointCrossover(const Lambda &mother, const Lambda& father)
 }
 
 void Lambda::onePointCrossover(const Lambda &mother, const Lambda& father, int q) {
-    for(int i = 0; i <= q; i++) { inherit(mother, i, i); }
+	checkpoints = mother.checkpoints;
+	GeneSet &inherited = GeneSet::forThread(static_cast<int>(order.size()));
+
+    for(int i = 0; i <= q; i++) {
+		inherit(mother, i, i);
+		inherited.insert(order[i]);
+	}
 
     for(int i = 0, ctr = q + 1; i<order.size(); i++) {
-        if(!Utils::rangeInclContains(order, 0, q, father.order[i])) {
+        if(!inherited.contains(father.order[i])) {
             inherit(father, ctr, i);
             ctr++;
         }
@@ -50,20 +70,26 @@ void Lambda::randomTwoPointCrossover(const Lambda &mother, const Lambda &father)
 
 void Lambda::twoPointCrossover(const Lambda &mother, const Lambda &father, int q1, int q2) {
     int len = static_cast<int>(order.size());
+	checkpoints = mother.checkpoints;
+
+	GeneSet &inherited = GeneSet::forThread(len);
 
     for (int i = 0, ctr = 0; i <= q1; i++, ctr++) {
         inherit(mother, ctr, i);
+		inherited.insert(order[ctr]);
     }
 
     for (int i = 0, ctr = q1 + 1; i < len && ctr <= q2; i++) {
-        if (!Utils::rangeInclContains(order, 0, q1, father.order[i])) {
+        if (!inherited.contains(father.order[i])) {
             inherit(father, ctr, i);
+			inherited.insert(order[ctr]);
             ctr++;
         }
     }
 
+	// Mother genes behind q1 never occur in her prefix, so testing against all inherited genes equals testing the middle segment
     for (int i = q1 + 1, ctr = q2 + 1; i < len && ctr < len; i++) {
-        if (!Utils::rangeInclContains(order, q1 + 1, q2, mother.order[i])) {
+        if (!inherited.contains(mother.order[i])) {
             inherit(mother, ctr, i);
             ctr++;
         }
@@ -196,7 +222,9 @@ void LambdaBeta::separateOnePointCrossover(const LambdaBeta& mother, const Lambd
 	int q1 = Utils::randRangeIncl(0, static_cast<int>(order.size() - 1));
 	int q2 = Utils::randRangeIncl(0, static_cast<int>(beta.size() - 1));
 	onePointCrossoverLists(q1, order, mother.order, father.order);
-	onePointCrossoverLists(q2, beta, mother.beta, father.beta);
+	// beta holds one value per position instead of a permutation, so the tail is copied from the father as is
+	for(int i = 0; i < beta.size(); i++)
+		beta[i] = i <= q2 ? mother.beta[i] : father.beta[i];
 }
 
 ProjectWithOvertime::BorderSchedulingOptions LambdaBeta::options;
@@ -318,11 +346,23 @@ void PartitionList::combine(const PartitionList &mother, const PartitionList &fa
 		plist[j] = mother.plist[j] <= q ? mother.plist[j] : -1;
 	}
 
+	// Remaining jobs ordered by their partition in father and then by index, as a stable counting sort
+	vector<int> numInFatherPartition(numPartitions + 1, 0);
+	for(int j=0; j<plist.size(); j++) {
+		if(plist[j] == -1)
+			numInFatherPartition[father.plist[j] + 1]++;
+	}
+	partial_sum(numInFatherPartition.begin(), numInFatherPartition.end(), numInFatherPartition.begin());
+
+	vector<int> remainingJobs(static_cast<size_t>(numInFatherPartition.back()));
+	for(int j=0; j<plist.size(); j++) {
+		if(plist[j] == -1)
+			remainingJobs[numInFatherPartition[father.plist[j]]++] = j;
+	}
+
 	int pix = q+1;
-	for(int i=0; i<plist.size()-(q+1)*partitionSize; i++) {
-		int j = lowestPartitionJobFromOtherNotAlreadyChosen(father.plist);
-		assert(j != -1);
-		plist[j] = pix;
+	for(int i=0; i<remainingJobs.size(); i++) {
+		plist[remainingJobs[i]] = pix;
 		if((i+1) % partitionSize == 0) {
 			pix++;
 		}
@@ -367,18 +407,3 @@ void PartitionList::partitionSwap(const Matrix<char> &adjMx, int pmutate, int pa
 		}
 	}
 }
-
-int PartitionList::lowestPartitionJobFromOtherNotAlreadyChosen(const std::vector<int> &other) {
-	int lowestPartition = numeric_limits<int>::max();
-	int lowestJob = -1;
-	for(int j=0; j<plist.size(); j++) {
-		if(plist[j] == -1 && other[j] < lowestPartition) {
-			lowestPartition = other[j];
-			lowestJob = j;
-		}
-	}
-	return lowestJob;
-}
-
-
-
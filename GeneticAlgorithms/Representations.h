@@ -8,9 +8,24 @@
 #include "../Utils.h"
 #include "../ProjectWithOvertime.h"
 
+// Per-thread reusable membership set over gene values in [0, numValues), reset in O(1) via generation stamps
+class GeneSet {
+public:
+	static GeneSet &forThread(int numValues);
+
+	void insert(int value) { stamps[value] = generation; }
+	bool contains(int value) const { return stamps[value] == generation; }
+
+private:
+	std::vector<unsigned int> stamps;
+	unsigned int generation = 0;
+};
+
 class Lambda {
 public:
     std::vector<int> order;
+	// SGS checkpoints of the last decoded activity list, inherited from the mother by crossover
+	std::shared_ptr<const SGSCheckpoints> checkpoints;
 
 	explicit Lambda(int numJobs);
 	explicit Lambda(const std::vector<int> &_order);
@@ -34,12 +49,15 @@ public:
 
 template <class T>
 void Lambda::onePointCrossoverLists(int q, std::vector<T> &daughter, const std::vector<T> &mother, const std::vector<T> &father) {
+	GeneSet &inherited = GeneSet::forThread(static_cast<int>(daughter.size()));
+
 	for(int i = 0; i <= q; i++) {
 		daughter[i] = mother[i];
+		inherited.insert(static_cast<int>(mother[i]));
 	}
 
-	for(int i = 0, ctr = q + 1; i < daughter.size(); i++) {
-		if(!Utils::rangeInclContains(daughter, 0, q, father[i])) {
+	for(int i = 0, ctr = q + 1; i < daughter.size() && ctr < daughter.size(); i++) {
+		if(!inherited.contains(static_cast<int>(father[i]))) {
 			daughter[ctr] = father[i];
 			ctr++;
 		}
@@ -194,5 +212,4 @@ private:
 	bool isFeasible(const Matrix<char> &adjMx) const;
 	int determineOtherJobForSwap(int j, MoveDir dir) const;
 
-	int lowestPartitionJobFromOtherNotAlreadyChosen(const std::vector<int> &other);
 };
\ No newline at end of file
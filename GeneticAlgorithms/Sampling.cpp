@@ -7,9 +7,59 @@
 #include <algorithm>
 #include <numeric>
 #include <random>
+#include <set>
 
 using namespace std;
 
+namespace {
+	// Fenwick tree over the priority values and the count of the eligible jobs. The regret weight of an
+	// eligible job is prio - minPrio + 1, so any prefix weight is sumPrio + count * (1 - minPrio).
+	class RegretWeightTree {
+	public:
+		explicit RegretWeightTree(int n) : n(n), prioSums(static_cast<size_t>(n + 1), 0.0), counts(static_cast<size_t>(n + 1), 0) {
+			for (highestBit = 1; highestBit * 2 <= n; highestBit *= 2);
+		}
+
+		void update(int job, double prio, int countDelta) {
+			for (int i = job + 1; i <= n; i += i & -i) {
+				prioSums[i] += prio * countDelta;
+				counts[i] += countDelta;
+			}
+		}
+
+		double totalWeight(double offset) const {
+			double prioSum = 0.0;
+			int count = 0;
+			for (int i = n; i > 0; i -= i & -i) {
+				prioSum += prioSums[i];
+				count += counts[i];
+			}
+			return prioSum + count * offset;
+		}
+
+		// Smallest job whose inclusive prefix weight reaches target
+		int find(double target, double offset) const {
+			int pos = 0;
+			for (int step = highestBit; step > 0; step /= 2) {
+				int next = pos + step;
+				if (next <= n) {
+					double w = prioSums[next] + counts[next] * offset;
+					if (w < target) {
+						pos = next;
+						target -= w;
+					}
+				}
+			}
+			return pos;
+		}
+
+	private:
+		int n, highestBit;
+		vector<double> prioSums;
+		vector<int> counts;
+	};
+}
+
 vector<float> Sampling::computeProbsForDecisionSet(const vector<bool> &eligible, const vector<float> &priorityValues) {
     int len = static_cast<int>(priorityValues.size());
     float minPrio = std::numeric_limits<float>::max(); // use filter iterator from boost instead?
@@ -59,25 +109,61 @@ void Sampling::updateEligible(const Project &p, const vector<int> &order, int cu
 }
 
 vector<int> Sampling::regretBasedBiasedRandomSampling(const Project &p, const vector<float> &priorityValues) {
-	vector<bool> eligible(p.numJobs, false);
-	vector<int> order(p.numJobs);
-	eligible[0] = true;
+	vector<int> order(p.numJobs), numUnscheduledPreds(p.numJobs);
+	RegretWeightTree weights(p.numJobs);
+	multiset<float> eligiblePrios;
+
+	auto makeEligible = [&](int j) {
+		weights.update(j, priorityValues[j], 1);
+		eligiblePrios.insert(priorityValues[j]);
+	};
+
+	for (int j = 0; j < p.numJobs; j++) {
+		numUnscheduledPreds[j] = static_cast<int>(p.preds[j].size());
+		if (numUnscheduledPreds[j] == 0)
+			makeEligible(j);
+	}
+
 	for (int i = 0; i < p.numJobs; i++) {
-		order[i] = pickFromDecisionSet(eligible, priorityValues);
-		updateEligible(p, order, i, eligible);
+		const double offset = 1.0 - *eligiblePrios.begin();
+		const double total = weights.totalWeight(offset);
+		// Every eligible job weighs at least one, clamping keeps rounding from leaving the eligible set
+		const double target = max(0.5, min(static_cast<double>(Utils::randUnitFloat()) * total, total - 0.5));
+		const int job = weights.find(target, offset);
+
+		order[i] = job;
+		weights.update(job, priorityValues[job], -1);
+		eligiblePrios.erase(eligiblePrios.find(priorityValues[job]));
+
+		for (int succ : p.succs[job]) {
+			if (--numUnscheduledPreds[succ] == 0)
+				makeEligible(succ);
+		}
 	}
 
 	return order;
 }
 
 vector<int> Sampling::naiveSampling(const Project& p) {
-	vector<bool> eligible(p.numJobs, false);
-	vector<int> order(p.numJobs);
-	eligible[0] = true;
+	vector<int> order(p.numJobs), numUnscheduledPreds(p.numJobs), eligible;
+	eligible.reserve(p.numJobs);
+
+	for (int j = 0; j < p.numJobs; j++) {
+		numUnscheduledPreds[j] = static_cast<int>(p.preds[j].size());
+		if (numUnscheduledPreds[j] == 0)
+			eligible.push_back(j);
+	}
+
 	for(int i = 0; i < p.numJobs; i++) {
-		int nth = Utils::randRangeIncl(0, static_cast<int>(count(eligible.begin(), eligible.end(), true))-1);
-		order[i] = Utils::indexOfNthEqualTo(nth, true, eligible);
-		updateEligible(p, order, i, eligible);
+		int nth = Utils::randRangeIncl(0, static_cast<int>(eligible.size()) - 1);
+		order[i] = eligible[nth];
+		eligible[nth] = eligible.back();
+		eligible.pop_back();
+
+		for (int succ : p.succs[order[i]]) {
+			if (--numUnscheduledPreds[succ] == 0)
+				eligible.push_back(succ);
+		}
 	}
 	return order;
 }
@@ -94,7 +180,7 @@ std::vector<int> Sampling::randomPermutation(int n) {
 	vector<int> p(n);
 	for(int i=0; i<n; i++)
 		p[i] = i;
-	shuffle(p.begin(), p.end(), std::mt19937(std::random_device()()));
+	shuffle(p.begin(), p.end(), Utils::randomEngine());
 	return p;
 }
 
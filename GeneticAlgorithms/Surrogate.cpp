@@ -0,0 +1,97 @@
+#include <cmath>
+
+#include "Surrogate.h"
+
+using namespace std;
+
+namespace Surrogate {
+
+	RidgeRegression::RidgeRegression(int _numFeatures, float _lambda)
+		: numFeatures(_numFeatures + 1), numSamples(0), lambda(_lambda),
+		xtx(static_cast<size_t>(numFeatures * numFeatures), 0.0), xty(static_cast<size_t>(numFeatures), 0.0), weights(static_cast<size_t>(numFeatures), 0.0) {}
+
+	void RidgeRegression::addSample(const vector<float> &x, float y) {
+		auto feature = [&](int i) { return i + 1 < numFeatures ? static_cast<double>(x[i]) : 1.0; };
+		for(int i = 0; i < numFeatures; i++) {
+			const double xi = feature(i);
+			xty[i] += xi * y;
+			for(int j = 0; j <= i; j++)
+				xtx[i * numFeatures + j] += xi * feature(j);
+		}
+		numSamples++;
+	}
+
+	void RidgeRegression::fit() {
+		// Cholesky decomposition of the lower triangle of X^T X + lambda I
+		vector<double> l(xtx.size(), 0.0);
+		for(int i = 0; i < numFeatures; i++) {
+			for(int j = 0; j <= i; j++) {
+				double sum = xtx[i * numFeatures + j];
+				if(i == j && i + 1 < numFeatures) sum += lambda;
+				for(int k = 0; k < j; k++)
+					sum -= l[i * numFeatures + k] * l[j * numFeatures + k];
+				if(i == j) {
+					if(sum <= 0.0) return;
+					l[i * numFeatures + i] = sqrt(sum);
+				} else {
+					l[i * numFeatures + j] = sum / l[j * numFeatures + j];
+				}
+			}
+		}
+
+		vector<double> tmp(static_cast<size_t>(numFeatures));
+		for(int i = 0; i < numFeatures; i++) {
+			double sum = xty[i];
+			for(int k = 0; k < i; k++)
+				sum -= l[i * numFeatures + k] * tmp[k];
+			tmp[i] = sum / l[i * numFeatures + i];
+		}
+		for(int i = numFeatures - 1; i >= 0; i--) {
+			double sum = tmp[i];
+			for(int k = i + 1; k < numFeatures; k++)
+				sum -= l[k * numFeatures + i] * weights[k];
+			weights[i] = sum / l[i * numFeatures + i];
+		}
+	}
+
+	float RidgeRegression::predict(const vector<float> &x) const {
+		double y = weights[numFeatures - 1];
+		for(int i = 0; i + 1 < numFeatures; i++)
+			y += weights[i] * x[i];
+		return static_cast<float>(y);
+	}
+
+	vector<float> rankFeatures(const vector<int> &order) {
+		vector<float> ranks(order.size());
+		for(int i = 0; i < static_cast<int>(order.size()); i++)
+			ranks[order[i]] = static_cast<float>(i) / static_cast<float>(order.size());
+		return ranks;
+	}
+
+	vector<float> features(const ProjectWithOvertime &p, const LambdaZr &indiv) {
+		vector<float> x = rankFeatures(indiv.order);
+		p.eachResConst([&](int r) {
+			x.push_back(p.zmax[r] > 0 ? static_cast<float>(indiv.z[r]) / static_cast<float>(p.zmax[r]) : 0.0f);
+		});
+		return x;
+	}
+
+	// Overtime genes are condensed into the mean relative overtime per resource
+	vector<float> features(const ProjectWithOvertime &p, const LambdaZrt &indiv) {
+		vector<float> x = rankFeatures(indiv.order);
+		p.eachResConst([&](int r) {
+			float zsum = 0.0f;
+			for(int t = 0; t < indiv.z.getN(); t++)
+				zsum += static_cast<float>(indiv.z(r, t));
+			x.push_back(p.zmax[r] > 0 && indiv.z.getN() > 0 ? zsum / static_cast<float>(p.zmax[r] * indiv.z.getN()) : 0.0f);
+		});
+		return x;
+	}
+
+	vector<float> features(const ProjectWithOvertime &, const LambdaBeta &indiv) {
+		vector<float> x = rankFeatures(indiv.order);
+		for(int b : indiv.beta)
+			x.push_back(static_cast<float>(b));
+		return x;
+	}
+}
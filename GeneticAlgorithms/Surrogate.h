@@ -0,0 +1,34 @@
+#pragma once
+
+#include <vector>
+
+#include "../ProjectWithOvertime.h"
+#include "Representations.h"
+
+namespace Surrogate {
+
+	// Online ridge regression keeping only the normal equations, so adding a sample costs O(d^2) and fitting O(d^3)
+	class RidgeRegression {
+	public:
+		explicit RidgeRegression(int _numFeatures, float _lambda = 1.0f);
+
+		void addSample(const std::vector<float> &x, float y);
+		void fit();
+		float predict(const std::vector<float> &x) const;
+
+		int getNumSamples() const { return numSamples; }
+
+	private:
+		int numFeatures, numSamples;
+		float lambda;
+		// Last feature is the constant bias term, which is not penalized
+		std::vector<double> xtx, xty, weights;
+	};
+
+	// Position of each job in the activity list scaled to [0,1]
+	std::vector<float> rankFeatures(const std::vector<int> &order);
+
+	std::vector<float> features(const ProjectWithOvertime &p, const LambdaZr &indiv);
+	std::vector<float> features(const ProjectWithOvertime &p, const LambdaZrt &indiv);
+	std::vector<float> features(const ProjectWithOvertime &p, const LambdaBeta &indiv);
+}
@@ -13,7 +13,7 @@ TimeWindowArbitraryDiscretizedGA::TimeWindowArbitraryDiscretizedGA(ProjectWithOv
 
 LambdaBeta TimeWindowArbitraryDiscretizedGA::init(int ix) {
 	LambdaBeta indiv(p.numJobs);
-	indiv.order = ix == 0 ? p.topOrder : Sampling::sample(params.rbbrs, p);
+	indiv.order = initialOrder(ix);
 	p.eachJob([&](int j) { indiv.beta[j] = ix == 0 ? 0 : Utils::randRangeIncl(0, ub-1); });
 	return indiv;
 }
@@ -53,7 +53,7 @@ TimeWindowArbitraryGA::TimeWindowArbitraryGA(ProjectWithOvertime &_p) : GeneticA
 
 LambdaTau TimeWindowArbitraryGA::init(int ix) {
     LambdaTau indiv(p.numJobs);
-    indiv.order = ix == 0 ? p.topOrder : Sampling::sample(params.rbbrs, p);
+    indiv.order = initialOrder(ix);
     p.eachJob([&](int j) { indiv.tau[j] = ix == 0 ? 0.0f : Utils::randUnitFloat(); });
     return indiv;
 }
@@ -94,7 +94,7 @@ TimeWindowBordersGA::TimeWindowBordersGA(ProjectWithOvertime &_p) : GeneticAlgor
 
 LambdaBeta TimeWindowBordersGA::init(int ix) {
     LambdaBeta indiv(p.numJobs);
-    indiv.order = ix == 0 ? p.topOrder : Sampling::sample(params.rbbrs, p);
+    indiv.order = initialOrder(ix);
     p.eachJob([&](int j) { indiv.beta[j] = ix == 0 ? 0 : Utils::randRangeIncl(0, 1); });
     return indiv;
 }
@@ -122,6 +122,10 @@ vector<int> TimeWindowBordersGA::decode(LambdaBeta& i) {
 	return p.serialSGSTimeWindowBordersWithForwardBackwardImprovement(i.order, i.beta, options, !params.enforceTopOrdering).sts;
 }
 
+vector<float> TimeWindowBordersGA::features(const LambdaBeta &i) const {
+	return Surrogate::features(p, i);
+}
+
 //======================================================================================================================
 
 ActivityListBasedGA::ActivityListBasedGA(ProjectWithOvertime &_p, const std::string &name, TDecoder _decoder) : GeneticAlgorithm(_p, name), decoder(_decoder) {
@@ -159,11 +163,13 @@ std::string ActivityListBasedGA::selectName(DecoderType type) {
 }
 
 ActivityListBasedGA::ActivityListBasedGA(ProjectWithOvertime & _p, DecoderType type): ActivityListBasedGA(_p, selectName(type), selectDecoder(type)) {
+	// the subproject solvers of the decoder are shared between calls
+	reentrantDecoding = type != DecoderType::OptimalSubschedules;
 }
 
 Lambda ActivityListBasedGA::init(int ix) {
     Lambda l;
-    l.order = ix == 0 ? p.topOrder : Sampling::sample(params.rbbrs, p);
+    l.order = initialOrder(ix);
     return l;
 }
 
@@ -21,6 +21,7 @@ protected:
     virtual void mutate(LambdaBeta &i) override;
     virtual FitnessResult fitness(LambdaBeta &i) override;
 	virtual std::vector<int> decode(LambdaBeta& i) override;
+	virtual std::vector<float> features(const LambdaBeta &i) const override;
 };
 
 class TimeWindowArbitraryGA : public GeneticAlgorithm<LambdaTau> {
@@ -0,0 +1,217 @@
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <boost/filesystem.hpp>
+
+#include "InstanceGenerator.h"
+#include "ProjectWithOvertime.h"
+
+using namespace std;
+
+namespace InstanceGenerator {
+
+	GeneratorParameters::GeneratorParameters()
+		: numJobs(30), numRes(4), networkComplexity(1.5f), resourceFactor(0.5f), resourceStrength(0.5f),
+		  numStartJobs(3), numFinishJobs(3), maxArcSpan(10), minDuration(1), maxDuration(10), minDemand(1), maxDemand(10), seed(1) {}
+
+	json11::Json GeneratorParameters::to_json() const {
+		return json11::Json::object {
+			{ "numJobs", numJobs },
+			{ "numRes", numRes },
+			{ "networkComplexity", networkComplexity },
+			{ "resourceFactor", resourceFactor },
+			{ "resourceStrength", resourceStrength },
+			{ "numStartJobs", numStartJobs },
+			{ "numFinishJobs", numFinishJobs },
+			{ "maxArcSpan", maxArcSpan },
+			{ "minDuration", minDuration },
+			{ "maxDuration", maxDuration },
+			{ "minDemand", minDemand },
+			{ "maxDemand", maxDemand },
+			{ "seed", seed }
+		};
+	}
+
+	void GeneratorParameters::from_json(const json11::Json &obj) {
+		const vector<pair<string, int *>> intFields = {
+			{ "numJobs", &numJobs }, { "numRes", &numRes }, { "numStartJobs", &numStartJobs }, { "numFinishJobs", &numFinishJobs },
+			{ "maxArcSpan", &maxArcSpan }, { "minDuration", &minDuration }, { "maxDuration", &maxDuration },
+			{ "minDemand", &minDemand }, { "maxDemand", &maxDemand }, { "seed", &seed }
+		};
+		for(const auto &field : intFields)
+			if(obj[field.first].is_number()) *field.second = obj[field.first].int_value();
+
+		const vector<pair<string, float *>> floatFields = {
+			{ "networkComplexity", &networkComplexity }, { "resourceFactor", &resourceFactor }, { "resourceStrength", &resourceStrength }
+		};
+		for(const auto &field : floatFields)
+			if(obj[field.first].is_number()) *field.second = static_cast<float>(obj[field.first].number_value());
+	}
+
+	namespace {
+		// Own range mapping instead of std distributions so instances are equal across standard libraries
+		class Random {
+		public:
+			explicit Random(int seed) : rng(static_cast<unsigned int>(seed)) {}
+			int rangeIncl(int lb, int ub) { return lb + static_cast<int>(rng() % static_cast<unsigned int>(ub - lb + 1)); }
+			template<class T>
+			void shuffle(vector<T> &v) {
+				for(int i = static_cast<int>(v.size()) - 1; i > 0; i--)
+					swap(v[i], v[rangeIncl(0, i)]);
+			}
+		private:
+			mt19937 rng;
+		};
+
+		struct Network {
+			vector<vector<int>> succs;
+			vector<vector<bool>> arcs;
+			int numArcs = 0;
+
+			explicit Network(int numJobs) : succs(numJobs), arcs(numJobs, vector<bool>(numJobs, false)) {}
+
+			void addArc(int i, int j) {
+				arcs[i][j] = true;
+				succs[i].push_back(j);
+				numArcs++;
+			}
+
+			// Arcs always point to higher indices, so only jobs up to j need to be visited
+			bool reachable(int i, int j) const {
+				vector<int> stack = { i };
+				vector<bool> visited(j - i + 1, false);
+				while(!stack.empty()) {
+					const int k = stack.back();
+					stack.pop_back();
+					if(k == j) return true;
+					for(int l : succs[k]) {
+						if(l <= j && !visited[l - i]) {
+							visited[l - i] = true;
+							stack.push_back(l);
+						}
+					}
+				}
+				return false;
+			}
+		};
+
+		// Every real job gets a predecessor and a successor, then non-redundant arcs are added until the network complexity is reached
+		Network generateNetwork(const GeneratorParameters &params, Random &rnd) {
+			const int n = params.numJobs, numJobs = n + 2, sink = numJobs - 1;
+			const int numStartJobs = max(1, min(params.numStartJobs, n)), numFinishJobs = max(1, min(params.numFinishJobs, n));
+			const int span = max(1, params.maxArcSpan);
+			Network net(numJobs);
+
+			for(int j = 1; j <= n; j++)
+				if(j <= numStartJobs) net.addArc(0, j);
+				else net.addArc(rnd.rangeIncl(max(1, j - span), j - 1), j);
+
+			for(int i = n; i >= 1; i--) {
+				if(!net.succs[i].empty()) continue;
+				if(i > n - numFinishJobs) net.addArc(i, sink);
+				else net.addArc(i, rnd.rangeIncl(i + 1, min(n, i + span)));
+			}
+
+			const int targetArcs = static_cast<int>(round(params.networkComplexity * numJobs));
+			for(int attempt = 0; net.numArcs < targetArcs && n > 1 && attempt < 20 * targetArcs; attempt++) {
+				const int i = rnd.rangeIncl(1, n - 1), j = rnd.rangeIncl(i + 1, min(n, i + span));
+				if(net.arcs[i][sink] || net.arcs[0][j] || net.reachable(i, j)) continue;
+				net.addArc(i, j);
+			}
+
+			return net;
+		}
+	}
+
+	string generateSmContents(const GeneratorParameters &params) {
+		Random rnd(params.seed);
+		const int n = params.numJobs, numJobs = n + 2, numRes = params.numRes;
+		const Network net = generateNetwork(params, rnd);
+
+		vector<int> durations(numJobs, 0);
+		for(int j = 1; j <= n; j++)
+			durations[j] = rnd.rangeIncl(params.minDuration, params.maxDuration);
+
+		// Resource factor counts dummy jobs in the denominator like collectCharacteristics does
+		vector<vector<int>> demands(numJobs, vector<int>(numRes, 0));
+		const int targetPositive = min(n * numRes, max(0, static_cast<int>(round(params.resourceFactor * numJobs * numRes))));
+		int numPositive = 0;
+		const auto addDemand = [&](int j, int r) {
+			if(numPositive >= targetPositive || demands[j][r] > 0) return;
+			demands[j][r] = rnd.rangeIncl(params.minDemand, params.maxDemand);
+			numPositive++;
+		};
+		for(int j = 1; j <= n && numRes > 0; j++)
+			addDemand(j, rnd.rangeIncl(0, numRes - 1));
+		vector<pair<int, int>> pairs;
+		for(int j = 1; j <= n; j++)
+			for(int r = 0; r < numRes; r++)
+				pairs.push_back({ j, r });
+		rnd.shuffle(pairs);
+		for(const auto &jr : pairs)
+			addDemand(jr.first, jr.second);
+
+		// Capacities interpolate between largest single demand and peak demand of the earliest start schedule
+		vector<int> ests(numJobs, 0);
+		for(int i = 0; i < numJobs; i++)
+			for(int j : net.succs[i])
+				ests[j] = max(ests[j], ests[i] + durations[i]);
+		const int horizon = accumulate(durations.begin(), durations.end(), 0);
+		vector<int> capacities(numRes);
+		for(int r = 0; r < numRes; r++) {
+			vector<int> usage(horizon + 1, 0);
+			int kmin = 0;
+			for(int j = 1; j <= n; j++) {
+				kmin = max(kmin, demands[j][r]);
+				for(int t = ests[j]; t < ests[j] + durations[j]; t++)
+					usage[t] += demands[j][r];
+			}
+			const int kmax = *max_element(usage.begin(), usage.end());
+			capacities[r] = max(1, kmin + static_cast<int>(round(params.resourceStrength * (kmax - kmin))));
+		}
+
+		const string separator = string(72, '*') + "\n";
+		stringstream ss;
+		ss << separator << "file with basedata            : generated.bas\n" << "initial value random generator: " << params.seed << "\n" << separator;
+		ss << "projects                      :  1\n";
+		ss << "jobs (incl. supersource/sink ):  " << numJobs << "\n";
+		ss << "horizon                       :  " << horizon << "\n";
+		ss << "RESOURCES\n";
+		ss << "  - renewable                 :  " << numRes << "   R\n";
+		ss << "  - nonrenewable              :  0   N\n";
+		ss << "  - doubly constrained        :  0   D\n" << separator;
+		ss << "PRECEDENCE RELATIONS:\n" << "jobnr.    #modes  #successors   successors\n";
+		for(int j = 0; j < numJobs; j++) {
+			vector<int> succs = net.succs[j];
+			sort(succs.begin(), succs.end());
+			ss << (j + 1) << " 1 " << succs.size();
+			for(int succ : succs) ss << " " << (succ + 1);
+			ss << "\n";
+		}
+		ss << separator << "REQUESTS/DURATIONS:\n" << "jobnr. mode duration\n" << string(72, '-') << "\n";
+		for(int j = 0; j < numJobs; j++) {
+			ss << (j + 1) << " 1 " << durations[j];
+			for(int r = 0; r < numRes; r++) ss << " " << demands[j][r];
+			ss << "\n";
+		}
+		ss << separator << "RESOURCEAVAILABILITIES:\n";
+		for(int r = 0; r < numRes; r++) ss << " R " << (r + 1);
+		ss << "\n";
+		for(int r = 0; r < numRes; r++) ss << " " << capacities[r];
+		ss << "\n" << separator;
+		return ss.str();
+	}
+
+	void generateToDisk(const GeneratorParameters &params, const string &filename) {
+		const string contents = generateSmContents(params);
+		const boost::filesystem::path path(filename);
+		if(path.extension() == ".json") {
+			ProjectWithOvertime p(path.stem().string(), contents);
+			p.to_disk(filename);
+		} else {
+			Utils::spit(contents, filename);
+		}
+	}
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <string>
+
+#include "JsonUtils.h"
+
+// ProGen-like random instance generator with the network complexity, resource factor and resource strength
+// definitions from ProjectWithOvertime::collectCharacteristics. Equal parameters (incl. seed) give equal instances.
+// Example parameters:
+// { "numJobs": 1000, "numRes": 4, "networkComplexity": 1.8, "resourceFactor": 0.5, "resourceStrength": 0.3, "seed": 1 }
+namespace InstanceGenerator {
+
+	struct GeneratorParameters : JsonUtils::IJsonSerializable {
+		// Number of real jobs, supersource and supersink are added
+		int numJobs, numRes;
+		// Arcs per job incl. dummy arcs
+		float networkComplexity;
+		// Share of job/resource pairs with positive demand
+		float resourceFactor;
+		// 0 means capacity equals the largest single demand, 1 means capacity equals the peak of the earliest start schedule
+		float resourceStrength;
+		int numStartJobs, numFinishJobs;
+		// Arcs between real jobs span at most this many indices, keeps the network deep for large job counts
+		int maxArcSpan;
+		int minDuration, maxDuration, minDemand, maxDemand;
+		int seed;
+
+		GeneratorParameters();
+		json11::Json to_json() const override;
+		void from_json(const json11::Json &obj) override;
+	};
+
+	// Instance in ProGen .sm layout, readable by Project(projectName, contents)
+	std::string generateSmContents(const GeneratorParameters &params);
+
+	// Writes .sm or, for a .json filename, the serialized ProjectWithOvertime
+	void generateToDisk(const GeneratorParameters &params, const std::string &filename);
+}
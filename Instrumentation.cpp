@@ -0,0 +1,79 @@
+#include "Instrumentation.h"
+
+#ifdef ENABLE_INSTRUMENTATION
+
+#include <memory>
+#include <mutex>
+#include "Utils.h"
+
+using namespace std;
+
+namespace Utils {
+	namespace Instrumentation {
+
+		namespace {
+			mutex registryMutex;
+			vector<unique_ptr<ThreadData>> registry;
+
+			const vector<string> counterNames = { "sgsCalls", "fbiIterations", "capacityChecks", "checkpointHits", "capacityProfileAllocations" };
+			const vector<string> timerNames = { "crossover", "mutation", "decode", "fbi", "selection", "tracing" };
+		}
+
+		ThreadData::ThreadData() {
+			counters.fill(0);
+			timerCycles.fill(0);
+			timerCalls.fill(0);
+		}
+
+		ThreadData &threadData() {
+			thread_local ThreadData *data = nullptr;
+			if(data == nullptr) {
+				lock_guard<mutex> lock(registryMutex);
+				registry.push_back(make_unique<ThreadData>());
+				data = registry.back().get();
+			}
+			return *data;
+		}
+
+		void reset() {
+			lock_guard<mutex> lock(registryMutex);
+			for(auto &data : registry)
+				*data = ThreadData();
+		}
+
+		json11::Json report() {
+			lock_guard<mutex> lock(registryMutex);
+
+			json11::Json::object counters, timers;
+			for(size_t c = 0; c < counterNames.size(); c++) {
+				uint64_t sum = 0;
+				for(auto &data : registry) sum += data->counters[c];
+				counters[counterNames[c]] = static_cast<double>(sum);
+			}
+
+			for(size_t t = 0; t < timerNames.size(); t++) {
+				uint64_t cycleSum = 0, callSum = 0;
+				for(auto &data : registry) {
+					cycleSum += data->timerCycles[t];
+					callSum += data->timerCalls[t];
+				}
+				timers[timerNames[t]] = json11::Json::object {
+					{ "cycles", static_cast<double>(cycleSum) },
+					{ "calls", static_cast<double>(callSum) }
+				};
+			}
+
+			return json11::Json::object {
+				{ "threads", static_cast<int>(registry.size()) },
+				{ "counters", counters },
+				{ "timers", timers }
+			};
+		}
+
+		void writeReport(const string &filename) {
+			Utils::spit(report().dump(), filename);
+		}
+	}
+}
+
+#endif
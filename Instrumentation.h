@@ -0,0 +1,95 @@
+#pragma once
+
+// Opt-in profiling counters and cycle timers, configure with -DENABLE_INSTRUMENTATION=ON.
+// Without the definition all INSTR_* macros expand to nothing.
+
+#ifdef ENABLE_INSTRUMENTATION
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <chrono>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "Libraries/json11.hpp"
+
+namespace Utils {
+	namespace Instrumentation {
+
+		enum class Counter {
+			SGS_CALLS = 0,
+			FBI_ITERATIONS,
+			CAPACITY_CHECKS,
+			CHECKPOINT_HITS,
+			CAPACITY_PROFILE_ALLOCATIONS,
+			NUM_COUNTERS
+		};
+
+		enum class Timer {
+			CROSSOVER = 0,
+			MUTATION,
+			DECODE,
+			FBI,
+			SELECTION,
+			TRACING,
+			NUM_TIMERS
+		};
+
+		// Owned by a global registry so the counts survive the worker threads that produced them
+		struct ThreadData {
+			std::array<uint64_t, static_cast<size_t>(Counter::NUM_COUNTERS)> counters;
+			std::array<uint64_t, static_cast<size_t>(Timer::NUM_TIMERS)> timerCycles, timerCalls;
+			ThreadData();
+		};
+
+		ThreadData &threadData();
+
+		inline uint64_t cycles() {
+#if defined(__x86_64__) || defined(__i386__)
+			return __rdtsc();
+#else
+			return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+		}
+
+		class ScopedTimer {
+		public:
+			explicit ScopedTimer(Timer _timer) : timer(_timer), start(cycles()) {}
+			~ScopedTimer() {
+				ThreadData &data = threadData();
+				data.timerCycles[static_cast<size_t>(timer)] += cycles() - start;
+				data.timerCalls[static_cast<size_t>(timer)]++;
+			}
+		private:
+			Timer timer;
+			uint64_t start;
+		};
+
+		// Only call while no other thread is instrumenting
+		void reset();
+		json11::Json report();
+		void writeReport(const std::string &filename);
+	}
+}
+
+#define INSTR_CONCAT_INNER(a, b) a##b
+#define INSTR_CONCAT(a, b) INSTR_CONCAT_INNER(a, b)
+
+#define INSTR_COUNT(counter) Utils::Instrumentation::threadData().counters[static_cast<size_t>(Utils::Instrumentation::Counter::counter)]++
+#define INSTR_ADD(counter, n) Utils::Instrumentation::threadData().counters[static_cast<size_t>(Utils::Instrumentation::Counter::counter)] += static_cast<uint64_t>(n)
+#define INSTR_TIME(timer) Utils::Instrumentation::ScopedTimer INSTR_CONCAT(instrTimer, __LINE__)(Utils::Instrumentation::Timer::timer)
+#define INSTR_RESET() Utils::Instrumentation::reset()
+#define INSTR_REPORT(filename) Utils::Instrumentation::writeReport(filename)
+
+#else
+
+#define INSTR_COUNT(counter)
+#define INSTR_ADD(counter, n)
+#define INSTR_TIME(timer)
+#define INSTR_RESET()
+#define INSTR_REPORT(filename)
+
+#endif
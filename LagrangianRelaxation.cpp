@@ -0,0 +1,151 @@
+#include <algorithm>
+#include <limits>
+
+#include "LagrangianRelaxation.h"
+#include "Bounds.h"
+#include "ProjectWithOvertime.h"
+#include "Utils.h"
+
+using namespace std;
+
+LagrangianRelaxation::LagrangianRelaxation(const ProjectWithOvertime &_p)
+	: p(_p), tails(Bounds(_p).getTails()), horizon(static_cast<int>(_p.revenue.size()) - 1), iterationCount(0),
+	  lambda(_p.numRes, Utils::max(0, horizon) + 1), minCosts(_p.numJobs), minStarts(_p.numJobs) {
+	for(int i = 1; i < p.numJobs - 1; i++)
+		for(int j : p.succs[i])
+			if(j != p.lastJob)
+				arcs.emplace_back(i, j);
+	mu.assign(arcs.size(), 0.0);
+}
+
+float LagrangianRelaxation::profitUpperBound(float targetProfit, int maxIterations) {
+	const int THETA_HALVING_INTERVAL = 20;
+	const double MIN_THETA = 1e-4;
+
+	iterationCount = 0;
+	if(horizon < tails[0])
+		return numeric_limits<float>::lowest();
+
+	lambda = Matrix<double>(p.numRes, horizon + 1);
+	mu.assign(arcs.size(), 0.0);
+
+	double bestBound = numeric_limits<double>::max(), theta = 2.0;
+	int iterationsWithoutImprovement = 0;
+	vector<int> sts(p.numJobs);
+	Matrix<int> usage(p.numRes, horizon + 1);
+
+	while(iterationCount < Utils::max(1, maxIterations)) {
+		solveSubproblems();
+		const double bound = solveRelaxation(sts);
+		iterationCount++;
+
+		if(bound < bestBound) {
+			bestBound = bound;
+			iterationsWithoutImprovement = 0;
+		} else if(++iterationsWithoutImprovement >= THETA_HALVING_INTERVAL) {
+			theta *= 0.5;
+			iterationsWithoutImprovement = 0;
+			if(theta < MIN_THETA) break;
+		}
+		if(bestBound <= targetProfit) break;
+
+		// subgradient at the relaxed schedule, periods after its makespan do not enter its bound
+		const int ms = sts[p.lastJob];
+		usage = Matrix<int>(p.numRes, horizon + 1);
+		for(int j = 0; j < p.numJobs; j++)
+			for(int r = 0; r < p.numRes; r++)
+				for(int tau = sts[j] + 1; tau <= sts[j] + p.durations[j]; tau++)
+					usage(r, tau) += p.demands(j, r);
+
+		const auto capacityViolation = [&](int r, int t) {
+			return static_cast<double>(usage(r, t) - p.capacities[r] - (lambda(r, t) > p.kappa[r] ? p.zmax[r] : 0));
+		};
+		const auto precedenceViolation = [&](size_t a) {
+			return static_cast<double>(sts[arcs[a].first] + p.durations[arcs[a].first] - sts[arcs[a].second]);
+		};
+
+		double normSq = 0.0;
+		for(int r = 0; r < p.numRes; r++)
+			for(int t = 1; t <= ms; t++)
+				normSq += capacityViolation(r, t) * capacityViolation(r, t);
+		for(size_t a = 0; a < arcs.size(); a++)
+			normSq += precedenceViolation(a) * precedenceViolation(a);
+		// multipliers are optimal
+		if(normSq == 0.0) break;
+
+		const double step = theta * (bound - targetProfit) / normSq;
+		for(int r = 0; r < p.numRes; r++)
+			for(int t = 1; t <= ms; t++)
+				lambda(r, t) = max(0.0, lambda(r, t) + step * capacityViolation(r, t));
+		for(size_t a = 0; a < arcs.size(); a++)
+			mu[a] = max(0.0, mu[a] + step * precedenceViolation(a));
+	}
+
+	return static_cast<float>(bestBound);
+}
+
+// Costs of starting job j at s are its weighted demand over the periods (s, s + d] and the precedence terms linear in s
+void LagrangianRelaxation::solveSubproblems() {
+	Matrix<double> cumulativeLambda(p.numRes, horizon + 1);
+	for(int r = 0; r < p.numRes; r++)
+		for(int t = 1; t <= horizon; t++)
+			cumulativeLambda(r, t) = cumulativeLambda(r, t - 1) + lambda(r, t);
+
+	vector<double> slopes(p.numJobs, 0.0);
+	for(size_t a = 0; a < arcs.size(); a++) {
+		slopes[arcs[a].first] += mu[a];
+		slopes[arcs[a].second] -= mu[a];
+	}
+
+	for(int j = 0; j < p.numJobs; j++) {
+		const int numStarts = horizon - tails[j] - p.ests[j] + 1;
+		minCosts[j].resize(static_cast<size_t>(numStarts));
+		minStarts[j].resize(static_cast<size_t>(numStarts));
+
+		for(int offset = 0; offset < numStarts; offset++) {
+			const int s = p.ests[j] + offset;
+			double costs = slopes[j] * s;
+			for(int r = 0; r < p.numRes; r++)
+				if(p.demands(j, r) > 0)
+					costs += p.demands(j, r) * (cumulativeLambda(r, s + p.durations[j]) - cumulativeLambda(r, s));
+
+			if(offset == 0 || costs < minCosts[j][offset - 1]) {
+				minCosts[j][offset] = costs;
+				minStarts[j][offset] = s;
+			} else {
+				minCosts[j][offset] = minCosts[j][offset - 1];
+				minStarts[j][offset] = minStarts[j][offset - 1];
+			}
+		}
+	}
+}
+
+// Maximum over the makespans of the relaxed profit, sts receives the relaxed schedule of the best makespan
+double LagrangianRelaxation::solveRelaxation(vector<int> &sts) const {
+	double constant = 0.0;
+	for(size_t a = 0; a < arcs.size(); a++)
+		constant -= mu[a] * p.durations[arcs[a].first];
+
+	double best = numeric_limits<double>::lowest(), capacityTerms = 0.0;
+	int bestMakespan = tails[0];
+	for(int ms = 1; ms <= horizon; ms++) {
+		// relaxed capacity constraints with the optimal overtime per period
+		for(int r = 0; r < p.numRes; r++)
+			capacityTerms += lambda(r, ms) * p.capacities[r] + max(0.0, lambda(r, ms) - p.kappa[r]) * p.zmax[r];
+		if(ms < tails[0]) continue;
+
+		double value = p.revenue[ms] + constant + capacityTerms;
+		for(int j = 0; j < p.numJobs; j++)
+			value -= minCosts[j][ms - tails[j] - p.ests[j]];
+
+		if(value > best) {
+			best = value;
+			bestMakespan = ms;
+		}
+	}
+
+	for(int j = 0; j < p.numJobs; j++)
+		sts[j] = minStarts[j][bestMakespan - tails[j] - p.ests[j]];
+	sts[p.lastJob] = bestMakespan;
+	return best;
+}
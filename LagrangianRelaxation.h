@@ -0,0 +1,37 @@
+#pragma once
+
+#include <vector>
+
+#include "Matrix.h"
+
+class ProjectWithOvertime;
+
+// Lagrangian relaxation of the capacity constraints with overtime and of the precedence constraints between real jobs.
+// For fixed multipliers and makespan ms the relaxation decomposes into one subproblem per job, choosing the cheapest
+// start in its time window [est, ms - tail], and the maximum over all makespans bounds the profit of any schedule.
+// The multipliers are lowered towards a known profit by subgradient optimization.
+class LagrangianRelaxation {
+public:
+	explicit LagrangianRelaxation(const ProjectWithOvertime &_p);
+
+	// Best bound found within maxIterations subgradient steps, targetProfit is the profit of a known schedule
+	float profitUpperBound(float targetProfit, int maxIterations);
+	int getIterationCount() const { return iterationCount; }
+
+private:
+	const ProjectWithOvertime &p;
+	std::vector<int> tails;
+	int horizon, iterationCount;
+
+	// Multipliers of the capacity constraints per resource and period and of the precedence arcs
+	Matrix<double> lambda;
+	std::vector<std::pair<int, int>> arcs;
+	std::vector<double> mu;
+
+	// Per job the cheapest start no later than est + offset and its costs
+	std::vector<std::vector<double>> minCosts;
+	std::vector<std::vector<int>> minStarts;
+
+	double solveRelaxation(std::vector<int> &sts) const;
+	void solveSubproblems();
+};
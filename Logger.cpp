@@ -4,6 +4,7 @@
 
 #include <iostream>
 #include <cmath>
+#include <algorithm>
 
 #include "Logger.h"
 #include "Utils.h"
@@ -12,80 +13,138 @@ using namespace std;
 
 namespace Utils {
 
-	Logger *Logger::instance = nullptr;
+	Logger::Logger(const string &_logName, LogMode _mode)
+		: logName(_logName), f(logName + "Log.txt"), mode(_mode),
+		sink([this](vector<Entry> &entries) { writeEntries(entries); }, [this] { f.flush(); cout.flush(); }) {
+	}
+
+	void Logger::log(LogLevel level, string message) {
+		if (!isEnabled(level)) return;
+		sink.push(Entry { level, time(nullptr), move(message) });
+		if(level == LogLevel::ERROR)
+			sink.flush();
+	}
 
-	Logger::Logger(const string &_logName, LogMode _mode) : logName(_logName), f(logName + "Log.txt"), mode(_mode) {
+	void Logger::flush() {
+		sink.flush();
 	}
 
-	void Logger::log(LogLevel level, const string &message) {
-		if (mode == LogMode::QUIET || (level == LogLevel::INFO && mode == LogMode::MEDIUM)) return;
-		string timestr = formattedNow();
-		f << "[" << logName << ", " << timestr << "]: " << message << endl;
-		f.flush();
-		cout << "[" << logName << ", " << timestr << "]: " << message << endl;
+	void Logger::writeEntries(vector<Entry> &entries) {
+		for(const Entry &entry : entries) {
+			const string line = "[" + logName + ", " + formattedTime(entry.time) + "]: " + entry.message + "\n";
+			f << line;
+			cout << line;
+		}
 	}
 
 	Logger *Logger::getInstance() {
-		if (!instance)
-			instance = new Logger("MainLogger", Utils::Logger::LogMode::VERBOSE);
-		return instance;
+		// Function local so the sink is drained and joined on exit
+		static Logger instance("MainLogger", Utils::Logger::LogMode::VERBOSE);
+		return &instance;
 	}
 
-	Tracer::Tracer(const string &filePrefix, TraceMode _traceMode) : f(filePrefix + ".txt"), traceMode(_traceMode), lastNumSchedules(0) {
+	Tracer::Tracer(const string &filePrefix, TraceMode _traceMode)
+		: f(filePrefix + ".txt"), traceMode(_traceMode), last_slvtime(0.0), lastUpdateSlvtime(0.0), lastNumSchedules(0),
+		sink([this](vector<Event> &events) { processBatch(events); }, [this] { f.flush(); }) {
 		sw.start();
-		lupdate = chrono::system_clock::now();
-		last_slvtime = 0.0;
 		if(!f.is_open())
 			throw runtime_error("Unable to create " + filePrefix + ".txt!");
 		f << "slvtime,bks_objval,nschedules,nindividuals\n";
-		trace(0.0, 0.0f, 0, 0);
+		writeLine(0.0, 0.0f, 0, 0, false);
 	}
 
-	Tracer::~Tracer() {
-		f.close();
+	void Tracer::record(EventKind kind, double slvtime, float bks_objval, int nschedules, int nindividuals) {
+		sink.push(Event { slvtime, bks_objval, nschedules, nindividuals, kind, traceMode.load(memory_order_relaxed) });
 	}
 
 	void Tracer::trace(double slvtime, float bks_objval, int nschedules, int nindividuals, bool trunc_secs) {
-		double insecs = (slvtime / 1000.0);
-		if (trunc_secs) insecs = trunc(insecs);
-		// FIXME: Specify number of decimal places!
-		// FIXME?: Write in stringbuffer and only write out to disk at the end?
-		f << (boost::format("%.2f") % insecs) << "," << bks_objval << "," << nschedules << "," << nindividuals << endl;
+		record(trunc_secs ? EventKind::DIRECT_TRUNC_SECS : EventKind::DIRECT, slvtime, bks_objval, nschedules, nindividuals);
 	}
 
-#define FIRST_EXCEED(curVal, lastVal, threshold) (curVal >= threshold && lastVal < threshold)
+	// Count and interval events are recorded in any mode for the anytime curve, the mode only filters the file output
+	void Tracer::countTrace(float bks_objval, int nschedules, int nindividuals) {
+		record(EventKind::COUNT, sw.look(), bks_objval, nschedules, nindividuals);
+	}
+
+	void Tracer::intervalTrace(float bks_objval, int nschedules, int nindividuals) {
+		record(EventKind::INTERVAL, sw.look(), bks_objval, nschedules, nindividuals);
+	}
+
+	void Tracer::setTraceMode(TraceMode _traceMode) {
+		traceMode = _traceMode;
+	}
+
+	void Tracer::flush() {
+		sink.flush();
+	}
 
-	void Tracer::countTrace(float bks_objval, int nschedules, int nindividuals) {		
-		if(traceMode == TraceMode::ONLY_INTERVAL) return;
+	vector<Tracer::TracePoint> Tracer::anytimeCurve() {
+		flush();
+		lock_guard<mutex> lock(curveMutex);
+		vector<TracePoint> curve = improvements;
+		if(latest && (curve.empty() || curve.back().secs != latest->secs || curve.back().nschedules != latest->nschedules))
+			curve.push_back(*latest);
+		return curve;
+	}
 
-		if(FIRST_EXCEED(nschedules, lastNumSchedules, 1000)
-			|| FIRST_EXCEED(nschedules, lastNumSchedules, 5000)
-			|| FIRST_EXCEED(nschedules, lastNumSchedules, 50000)) {
-			trace(sw.look(), bks_objval, nschedules, nindividuals);
+	void Tracer::processBatch(vector<Event> &events) {
+		stable_sort(events.begin(), events.end(), [](const Event &a, const Event &b) { return a.slvtime < b.slvtime; });
+		lock_guard<mutex> lock(curveMutex);
+		for(const Event &e : events) {
+			recordAnytimePoint(e);
+			process(e);
 		}
-		lastNumSchedules = nschedules;
 	}
 
-	void Tracer::intervalTrace(float bks_objval, int nschedules, int nindividuals) {
-		if (traceMode == TraceMode::ONLY_COUNT) return;
-		double slvtime = sw.look();
-		double deltat = chrono::duration<double, milli>(chrono::system_clock::now() - lupdate).count();
-		if(slvtime < 1000.0 && deltat >= MSECS_BETWEEN_TRACES_SHORT) {
-			lupdate = chrono::system_clock::now();
-			trace(slvtime, bks_objval, nschedules, nindividuals);
-		} else if(slvtime >= 1000.0 && last_slvtime < 1000.0) {
-			lupdate = chrono::system_clock::now();
-			trace(slvtime, bks_objval, nschedules, nindividuals, true);
-		} else if(slvtime >= 1000.0 && deltat >= MSECS_BETWEEN_TRACES_LONG) {
-			//cout << "Nodes visited = " << nodeCtr << ", Boundings = " << boundCtr << ", Opt = " << lb << ", Time = " << (boost::format("%.2f") % (sw.look() / 1000.0)) << endl;
-			lupdate = chrono::system_clock::now();
-			trace(slvtime, bks_objval, nschedules, nindividuals, true);
+	void Tracer::recordAnytimePoint(const Event &e) {
+		const TracePoint point = { e.slvtime / 1000.0, e.bks_objval, e.nschedules, e.nindividuals };
+		if(improvements.empty() || e.bks_objval > improvements.back().bks_objval)
+			improvements.push_back(point);
+		latest = point;
+	}
+
+#define FIRST_EXCEED(curVal, lastVal, threshold) (curVal >= threshold && lastVal < threshold)
+
+	void Tracer::process(const Event &e) {
+		switch(e.kind) {
+		case EventKind::DIRECT:
+		case EventKind::DIRECT_TRUNC_SECS:
+			writeLine(e.slvtime, e.bks_objval, e.nschedules, e.nindividuals, e.kind == EventKind::DIRECT_TRUNC_SECS);
+			break;
+
+		case EventKind::COUNT:
+			if(e.traceMode == TraceMode::ONLY_INTERVAL) break;
+			if(FIRST_EXCEED(e.nschedules, lastNumSchedules, 1000)
+				|| FIRST_EXCEED(e.nschedules, lastNumSchedules, 5000)
+				|| FIRST_EXCEED(e.nschedules, lastNumSchedules, 50000)) {
+				writeLine(e.slvtime, e.bks_objval, e.nschedules, e.nindividuals, false);
+			}
+			lastNumSchedules = e.nschedules;
+			break;
+
+		case EventKind::INTERVAL: {
+			if(e.traceMode == TraceMode::ONLY_COUNT) break;
+			const double deltat = e.slvtime - lastUpdateSlvtime;
+			if(e.slvtime < 1000.0 && deltat >= MSECS_BETWEEN_TRACES_SHORT) {
+				lastUpdateSlvtime = e.slvtime;
+				writeLine(e.slvtime, e.bks_objval, e.nschedules, e.nindividuals, false);
+			} else if(e.slvtime >= 1000.0 && last_slvtime < 1000.0) {
+				lastUpdateSlvtime = e.slvtime;
+				writeLine(e.slvtime, e.bks_objval, e.nschedules, e.nindividuals, true);
+			} else if(e.slvtime >= 1000.0 && deltat >= MSECS_BETWEEN_TRACES_LONG) {
+				lastUpdateSlvtime = e.slvtime;
+				writeLine(e.slvtime, e.bks_objval, e.nschedules, e.nindividuals, true);
+			}
+			last_slvtime = e.slvtime;
+			break;
+		}
 		}
-		last_slvtime = slvtime;
 	}
 
-	void Tracer::setTraceMode(TraceMode _traceMode) {
-		traceMode = _traceMode;
+	void Tracer::writeLine(double slvtime, float bks_objval, int nschedules, int nindividuals, bool trunc_secs) {
+		double insecs = (slvtime / 1000.0);
+		if (trunc_secs) insecs = trunc(insecs);
+		f << (boost::format("%.2f") % insecs) << "," << bks_objval << "," << nschedules << "," << nindividuals << "\n";
 	}
 
 }
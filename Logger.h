@@ -6,7 +6,39 @@
 
 #include <string>
 #include <fstream>
+#include <cstdint>
+#include <atomic>
+#include <vector>
+#include <ctime>
+#include <mutex>
+#include <boost/optional.hpp>
 #include "Stopwatch.h"
+#include "AsyncSink.h"
+
+// Levels below LOG_MIN_LEVEL (0=INFO, 1=WARNING, 2=ERROR) are compiled out entirely, set via -DLOG_MIN_LEVEL=n.
+#ifndef LOG_MIN_LEVEL
+#define LOG_MIN_LEVEL 0
+#endif
+
+// The message expression is only evaluated if the logger would actually emit the level
+#define LOG_AT(level, msg) do { \
+		Utils::Logger *logger_ = Utils::Logger::getInstance(); \
+		if(logger_->isEnabled(level)) logger_->log(level, msg); \
+	} while(false)
+
+#if LOG_MIN_LEVEL <= 0
+#define LOG_I(msg) LOG_AT(Utils::Logger::LogLevel::INFO, msg)
+#else
+#define LOG_I(msg) ((void)0)
+#endif
+
+#if LOG_MIN_LEVEL <= 1
+#define LOG_W(msg) LOG_AT(Utils::Logger::LogLevel::WARNING, msg)
+#else
+#define LOG_W(msg) ((void)0)
+#endif
+
+#define LOG_E(msg) LOG_AT(Utils::Logger::LogLevel::ERROR, msg)
 
 namespace Utils {
 
@@ -24,20 +56,35 @@ namespace Utils {
 			VERBOSE
 		};
 
+		Logger(const std::string &_logName, LogMode _mode);
+
+		bool isEnabled(LogLevel level) const {
+			return mode != LogMode::QUIET && !(level == LogLevel::INFO && mode == LogMode::MEDIUM);
+		}
+
+		// Only enqueues the message, the sink thread formats and writes it. Errors block until written.
+		void log(LogLevel level, std::string message);
+		void flush();
+
+		static Logger *getInstance();
+
 	private:
+		struct Entry {
+			LogLevel level;
+			time_t time;
+			std::string message;
+		};
+
 		std::string logName;
 		std::ofstream f;
 		LogMode mode;
-		static Logger *instance;
-
-	public:
-		Logger(const std::string &_logName, LogMode _mode);
-
-		void log(LogLevel level, const std::string &message);
+		AsyncSink<Entry> sink;
 
-		static Logger *getInstance();
+		void writeEntries(std::vector<Entry> &entries);
 	};
 
+	// Trace calls only record binary events into the async sink ring of the calling thread.
+	// The sink thread applies the count/interval filters while producing the text trace.
 	class Tracer {
 	public:
 		enum class TraceMode {
@@ -47,7 +94,6 @@ namespace Utils {
 		};
 
 		explicit Tracer(const std::string &filePrefix = "SolverTrace", TraceMode _traceMode = TraceMode::ONLY_INTERVAL);
-		~Tracer();
 
 		void trace(double slvtime, float bks_objval, int nschedules, int nindividuals, bool trunc_secs = false);
 
@@ -56,13 +102,53 @@ namespace Utils {
 
 		void setTraceMode(TraceMode _traceMode);
 
+		// Blocks until all events recorded so far are written out
+		void flush();
+
+		struct TracePoint {
+			double secs;
+			float bks_objval;
+			int nschedules, nindividuals;
+		};
+
+		// Every event that improved the objective followed by the latest event, independent of the file filters
+		std::vector<TracePoint> anytimeCurve();
+
 	private:
+		enum class EventKind : uint8_t {
+			DIRECT = 0,
+			DIRECT_TRUNC_SECS,
+			COUNT,
+			INTERVAL
+		};
+
+		struct Event {
+			double slvtime;
+			float bks_objval;
+			int nschedules, nindividuals;
+			EventKind kind;
+			TraceMode traceMode;
+		};
+
 		std::ofstream f;
-		std::chrono::time_point<std::chrono::system_clock> lupdate;
-		double last_slvtime;
 		Stopwatch sw;
-		TraceMode traceMode;
+		std::atomic<TraceMode> traceMode;
+
+		// Only touched by the sink thread
+		double last_slvtime, lastUpdateSlvtime;
 		int lastNumSchedules;
+
+		std::mutex curveMutex;
+		std::vector<TracePoint> improvements;
+		boost::optional<TracePoint> latest;
+
+		AsyncSink<Event> sink;
+
+		void record(EventKind kind, double slvtime, float bks_objval, int nschedules, int nindividuals);
+		void processBatch(std::vector<Event> &events);
+		void process(const Event &e);
+		void recordAnytimePoint(const Event &e);
+		void writeLine(double slvtime, float bks_objval, int nschedules, int nindividuals, bool trunc_secs);
 	};
 
 }
\ No newline at end of file
@@ -0,0 +1,125 @@
+#include <cstring>
+#include <stdexcept>
+#include <sstream>
+#include <boost/algorithm/string/predicate.hpp>
+
+#include "NodeLog.h"
+#include "Utils.h"
+
+using namespace std;
+
+namespace {
+	const char MAGIC[4] = { 'B', 'B', 'N', 'L' };
+	const uint32_t VERSION = 1;
+	// Packed record on disk: node, parent, job, start, bound and reason
+	const size_t RECORD_BYTES = 4 * sizeof(int32_t) + sizeof(float) + sizeof(uint8_t);
+
+	const char *reasonName(NodeLog::Reason reason) {
+		switch(reason) {
+			case NodeLog::Reason::Visited: return "visited";
+			case NodeLog::Reason::Leaf: return "leaf";
+			case NodeLog::Reason::Bound: return "bound";
+			case NodeLog::Reason::Dominance: return "dominance";
+			case NodeLog::Reason::Transposition: return "transposition";
+			case NodeLog::Reason::Propagation: return "propagation";
+		}
+		return "unknown";
+	}
+}
+
+NodeLog::NodeLog(const string &filename, size_t bufferRecords)
+	: out(filename, ios::binary | ios::trunc), buffer(Utils::max(1, static_cast<int>(bufferRecords)) * RECORD_BYTES), bufferBytes(0), recordCount(0) {
+	if(!out)
+		throw runtime_error("Unable to open node log " + filename);
+	out.write(MAGIC, sizeof(MAGIC));
+	out.write(reinterpret_cast<const char *>(&VERSION), sizeof(VERSION));
+}
+
+NodeLog::~NodeLog() {
+	flush();
+}
+
+void NodeLog::append(const Record &record) {
+	lock_guard<mutex> lock(bufferMutex);
+	if(bufferBytes + RECORD_BYTES > buffer.size())
+		flushBuffer();
+
+	char *pos = buffer.data() + bufferBytes;
+	const int32_t ints[4] = { record.node, record.parent, record.job, record.start };
+	memcpy(pos, ints, sizeof(ints));
+	memcpy(pos + sizeof(ints), &record.bound, sizeof(float));
+	pos[sizeof(ints) + sizeof(float)] = static_cast<char>(record.reason);
+
+	bufferBytes += RECORD_BYTES;
+	recordCount++;
+}
+
+void NodeLog::flush() {
+	lock_guard<mutex> lock(bufferMutex);
+	flushBuffer();
+	out.flush();
+}
+
+void NodeLog::flushBuffer() {
+	out.write(buffer.data(), bufferBytes);
+	bufferBytes = 0;
+}
+
+vector<NodeLog::Record> NodeLog::read(const string &filename) {
+	ifstream in(filename, ios::binary);
+	char magic[sizeof(MAGIC)];
+	uint32_t version = 0;
+	in.read(magic, sizeof(magic));
+	in.read(reinterpret_cast<char *>(&version), sizeof(version));
+	if(!in || memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 || version != VERSION)
+		throw runtime_error("No node log of version " + to_string(VERSION) + ": " + filename);
+
+	vector<Record> records;
+	char raw[RECORD_BYTES];
+	while(in.read(raw, RECORD_BYTES)) {
+		Record record;
+		int32_t ints[4];
+		memcpy(ints, raw, sizeof(ints));
+		memcpy(&record.bound, raw + sizeof(ints), sizeof(float));
+		record.node = ints[0];
+		record.parent = ints[1];
+		record.job = ints[2];
+		record.start = ints[3];
+		record.reason = static_cast<Reason>(raw[sizeof(ints) + sizeof(float)]);
+		records.push_back(record);
+	}
+	return records;
+}
+
+string NodeLog::toDot(const vector<Record> &records) {
+	stringstream ss;
+	ss << "digraph bbtree{\n";
+	for(size_t i = 0; i < records.size(); i++) {
+		const Record &r = records[i];
+		if(r.reason == Reason::Visited) {
+			ss << r.node << "[label=\"#" << r.node << "\\nj" << r.job << "@" << r.start << "\\nub=" << r.bound << "\"]\n";
+			if(r.parent > 0) ss << r.parent << "->" << r.node << "\n";
+		} else if(r.reason == Reason::Leaf) {
+			ss << "leaf" << i << "[shape=box,label=\"ms=" << r.start << "\\nprofit=" << r.bound << "\"]\n";
+			ss << r.node << "->leaf" << i << "\n";
+		} else {
+			ss << "pruned" << i << "[shape=box,style=dashed,label=\"j" << r.job << "@" << r.start << "\\n" << reasonName(r.reason) << "\"]\n";
+			if(r.parent > 0) ss << r.parent << "->pruned" << i << "[style=dashed]\n";
+		}
+	}
+	ss << "}\n";
+	return ss.str();
+}
+
+string NodeLog::toCsv(const vector<Record> &records) {
+	stringstream ss;
+	ss << "node,parent,job,start,bound,reason\n";
+	for(const Record &r : records)
+		ss << r.node << "," << r.parent << "," << r.job << "," << r.start << "," << r.bound << "," << reasonName(r.reason) << "\n";
+	return ss.str();
+}
+
+void NodeLog::convert(const string &logFilename, const string &outFilename) {
+	const vector<Record> records = read(logFilename);
+	Utils::spit(boost::ends_with(outFilename, ".dot") ? toDot(records) : toCsv(records), outFilename);
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Binary log of the nodes of a branch and bound search, streamed to disk through a fixed size buffer.
+// Every visited node and every pruned candidate is one fixed size record, so million-node searches only cost
+// disk space. The converters turn the log of a small search into a DOT graph or a CSV table.
+class NodeLog {
+public:
+	enum class Reason : uint8_t {
+		Visited = 0,
+		// Only the sink is left, start is the makespan and bound the profit of the schedule
+		Leaf,
+		Bound,
+		Dominance,
+		Transposition,
+		Propagation
+	};
+
+	// Candidates pruned before they became a node have node id -1 and the node they were generated from as parent.
+	// Dominated candidates have no bound and store the float maximum.
+	struct Record {
+		int32_t node, parent, job, start;
+		float bound;
+		Reason reason;
+	};
+
+	explicit NodeLog(const std::string &filename, size_t bufferRecords = 1 << 14);
+	~NodeLog();
+
+	// Safe to call from several threads
+	void append(const Record &record);
+	void flush();
+	uint64_t getRecordCount() const { return recordCount; }
+
+	static std::vector<Record> read(const std::string &filename);
+	static std::string toDot(const std::vector<Record> &records);
+	static std::string toCsv(const std::vector<Record> &records);
+	// Writes the DOT graph for a .dot target and the CSV table otherwise
+	static void convert(const std::string &logFilename, const std::string &outFilename);
+
+private:
+	std::ofstream out;
+	std::vector<char> buffer;
+	size_t bufferBytes;
+	uint64_t recordCount;
+	std::mutex bufferMutex;
+
+	void flushBuffer();
+};
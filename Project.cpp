@@ -4,6 +4,7 @@
 
 #include <numeric>
 #include <list>
+#include <queue>
 #include <algorithm>
 #include <string>
 #include <cmath>
@@ -13,11 +14,13 @@
 
 #include "Project.h"
 #include "Logger.h"
+#include "Instrumentation.h"
 
 using namespace std;
 
 Project::Project(JsonWrap obj) {
 	Project::from_json(obj.obj);
+	computeAdjacencyLists();
     heuristicMaxMs = makespan(serialSGS(topOrder));
 }
 
@@ -46,6 +49,7 @@ Project::Project(const string& projectName, const vector<string>& lines) : name(
 	T = accumulate(durations.begin(), durations.end(), 0);
 	numPeriods = T + 1;
 
+	computeAdjacencyLists();
 	topOrder = computeTopOrder();
 	revTopOrder = computeReverseTopOrder();
 
@@ -94,6 +98,7 @@ Matrix<int> Project::resRemForPartial(const vector<int> &sts) const {
 
 SGSResult Project::serialSGS(const vector<int>& order, const vector<int>& z, bool robust) const {
     Matrix<int> resRem(numRes, numPeriods, [&](int r, int t) { return capacities[r] + z[r]; });
+	INSTR_COUNT(CAPACITY_PROFILE_ALLOCATIONS);
 	const vector<int> sts = serialSGSCore(order, resRem, robust);
 	eachResPeriodConst([&](int r, int t) { resRem(r, t) -= z[r]; });
 	return{ sts, resRem, 1 };
@@ -103,12 +108,90 @@ SGSResult Project::serialSGS(const vector<int>& order, const Matrix<int>& z, boo
     Matrix<int> resRem(numRes, numPeriods, [&](int r, int t) {
 	    return capacities[r] + (t >= z.getN() ? 0 : z(r,t));
     });
+	INSTR_COUNT(CAPACITY_PROFILE_ALLOCATIONS);
 	const vector<int> sts = serialSGSCore(order, resRem, robust);
 	z.foreach([&](int r, int t, int zrt) { resRem(r, t) -= zrt; });
 	return{ sts, resRem, 1 };
 }
 
+SGSResult Project::serialSGS(const vector<int>& order, const vector<int>& z, const SGSCheckpoints *previous, SGSCheckpoints &recorded, int numCheckpoints) const {
+	Matrix<int> resRem(numRes, numPeriods, [&](int r, int t) { return capacities[r] + z[r]; });
+	recorded.z = Matrix<int>(Matrix<int>::Mode::ROW_VECTOR, z);
+	// Constant overtime raises the capacity of every period, so any change invalidates all snapshots
+	const int zAgreedPeriods = previous != nullptr && previous->z == recorded.z ? numPeriods : 0;
+	INSTR_COUNT(CAPACITY_PROFILE_ALLOCATIONS);
+	const vector<int> sts = serialSGSCoreWithCheckpoints(order, resRem, previous, zAgreedPeriods, recorded, numCheckpoints);
+	eachResPeriodConst([&](int r, int t) { resRem(r, t) -= z[r]; });
+	return{ sts, resRem, 1 };
+}
+
+SGSResult Project::serialSGS(const vector<int>& order, const Matrix<int>& z, const SGSCheckpoints *previous, SGSCheckpoints &recorded, int numCheckpoints) const {
+	Matrix<int> resRem(numRes, numPeriods, [&](int r, int t) {
+		return capacities[r] + (t >= z.getN() ? 0 : z(r, t));
+	});
+	recorded.z = z;
+	int zAgreedPeriods = 0;
+	if(previous != nullptr) {
+		const auto zAt = [&](const Matrix<int> &zm, int r, int t) { return t >= zm.getN() ? 0 : zm(r, t); };
+		const auto agreesInPeriod = [&](int t) {
+			for(int r = 0; r < numRes; r++)
+				if(zAt(previous->z, r, t) != zAt(z, r, t)) return false;
+			return true;
+		};
+		while(zAgreedPeriods < numPeriods && agreesInPeriod(zAgreedPeriods)) zAgreedPeriods++;
+	}
+	INSTR_COUNT(CAPACITY_PROFILE_ALLOCATIONS);
+	const vector<int> sts = serialSGSCoreWithCheckpoints(order, resRem, previous, zAgreedPeriods, recorded, numCheckpoints);
+	z.foreach([&](int r, int t, int zrt) { resRem(r, t) -= zrt; });
+	return{ sts, resRem, 1 };
+}
+
+vector<int> Project::serialSGSCoreWithCheckpoints(const vector<int>& order, Matrix<int>& resRem, const SGSCheckpoints *previous, int zAgreedPeriods, SGSCheckpoints &recorded, int numCheckpoints) const {
+	const int interval = max(1, static_cast<int>(ceil(static_cast<double>(numJobs) / (numCheckpoints + 1))));
+	vector<int> sts(numJobs, UNSCHEDULED), fts(numJobs, UNSCHEDULED);
+
+	INSTR_COUNT(SGS_CALLS);
+
+	recorded.order = order;
+	recorded.snapshots.clear();
+	recorded.resumedPosition = 0;
+
+	// Resume from the last snapshot taken before the first position where order deviates from the previous one.
+	// Scheduling the prefix only inspected periods up to its latest finish, so z may differ after that.
+	if(previous != nullptr) {
+		const int firstDiff = static_cast<int>(mismatch(order.begin(), order.end(), previous->order.begin()).first - order.begin());
+		for(const auto &snapshot : previous->snapshots) {
+			if (snapshot->position > firstDiff || snapshot->lastFinish >= zAgreedPeriods) break;
+			recorded.snapshots.push_back(snapshot);
+		}
+		if(!recorded.snapshots.empty()) {
+			const SGSCheckpoint &snapshot = *recorded.snapshots.back();
+			recorded.resumedPosition = snapshot.position;
+			INSTR_COUNT(CHECKPOINT_HITS);
+			sts = snapshot.sts;
+			EACH_JOB(if (sts[j] != UNSCHEDULED) fts[j] = sts[j] + durations[j])
+			// No scheduled job is active after lastFinish, there resRem keeps the capacities of the new z
+			EACH_RES(for(int t = 0; t <= snapshot.lastFinish; t++) resRem(r, t) = snapshot.resRem(r, t))
+		}
+	}
+
+	int lastFinish = recorded.resumedPosition > 0 ? recorded.snapshots.back()->lastFinish : 0;
+	for (int i = recorded.resumedPosition; i < numJobs; i++) {
+		if(i > recorded.resumedPosition && i % interval == 0 && i / interval <= numCheckpoints) {
+			recorded.snapshots.push_back(make_shared<const SGSCheckpoint>(SGSCheckpoint { i, lastFinish, sts, resRem }));
+		}
+		const int job = order[i];
+		const int lastPredFinished = computeLastPredFinishingTime(fts, job);
+		int t;
+		for (t = lastPredFinished; !enoughCapacityForJob(job, t, resRem); t++);
+		scheduleJobAt(job, t, sts, fts, resRem);
+		lastFinish = max(lastFinish, fts[job]);
+	}
+	return sts;
+}
+
 vector<int> Project::serialSGSCoreWithRandomKey(const std::vector<float>& rk, Matrix<int>& resRem) const {
+	INSTR_COUNT(SGS_CALLS);
 	vector<int> sts(numJobs, UNSCHEDULED), fts(numJobs, UNSCHEDULED);
 	for (int i = 0; i < numJobs; i++) {
 		const int job = chooseEligibleWithHighestPriority(sts, rk);
@@ -317,6 +400,7 @@ bool Project::allSuccsScheduled(int j, const vector<bool>& unscheduled) const {
 
 
 vector<int> Project::serialSGSCore(const vector<int>& order, Matrix<int>& resRem, bool robust) const {
+	INSTR_COUNT(SGS_CALLS);
 	vector<int> sts(numJobs, UNSCHEDULED), fts(numJobs, UNSCHEDULED);
 	for (int i = 0; i < numJobs; i++) {
 		const int job = robust ? chooseEligibleWithLowestIndex(sts, order) : order[i];
@@ -393,6 +477,7 @@ int Project::computeFirstSuccStartingTimeForPartial(const vector<int> &sts, int
 }
 
 bool Project::enoughCapacityForJob(int job, int t, const Matrix<int> & resRem) const {
+	INSTR_COUNT(CAPACITY_CHECKS);
     ACTIVE_PERIODS(job, t, EACH_RES(if(demands(job,r) > resRem(r,tau)) return false))
     return true;
 }
@@ -453,32 +538,49 @@ int Project::makespanOfPartial(const std::vector<int>& sts) const {
 	return ms;
 }
 
-template <class Pred>
-vector<int> Project::topOrderComputationCore(Pred isEligible) const {
-	vector<int> order(numJobs);
-	
-	for (int curIndex = 0; curIndex < numJobs; curIndex++) {
-		for (int job = 0; job < numJobs; job++) {
-			if (isEligible(curIndex, job, order)) {
-				order[curIndex] = job;
-				break;
-			}
-		}
+// Kahn's algorithm, always taking the lowest eligible job index so the order matches the former quadratic scan
+vector<int> Project::topOrderComputationCore(const vector<vector<int>> &before, const vector<vector<int>> &after) const {
+	vector<int> order, numMissing(numJobs);
+	order.reserve(numJobs);
+	priority_queue<int, vector<int>, greater<int>> eligible;
+
+	for (int job = 0; job < numJobs; job++) {
+		numMissing[job] = static_cast<int>(before[job].size());
+		if (numMissing[job] == 0) eligible.push(job);
+	}
+
+	while (!eligible.empty()) {
+		const int job = eligible.top();
+		eligible.pop();
+		order.push_back(job);
+		for (int next : after[job])
+			if (--numMissing[next] == 0) eligible.push(next);
 	}
 
+	if (order.size() != numJobs)
+		throw runtime_error("Precedence network is cyclic, only " + to_string(order.size()) + " of " + to_string(numJobs) + " jobs could be ordered!");
 	return order;
 }
 
 vector<int> Project::computeTopOrder() const {
-	return topOrderComputationCore([&](int curIndex, int job, const vector<int> &order) {
-		return !jobBeforeInOrder(job, curIndex, order) && !hasPredNotBeforeInOrder(job, curIndex, order);
-	});
+	return topOrderComputationCore(preds, succs);
 }
 
 vector<int> Project::computeReverseTopOrder() const {
-	return topOrderComputationCore([&](int curIndex, int job, const vector<int> &order) {
-		return !jobBeforeInOrder(job, curIndex, order) && !hasSuccNotBeforeInOrder(job, curIndex, order);
-	});
+	return topOrderComputationCore(succs, preds);
+}
+
+void Project::computeAdjacencyLists() {
+	preds.assign(numJobs, {});
+	succs.assign(numJobs, {});
+	for(int i = 0; i < numJobs; i++) {
+		for(int j = 0; j < numJobs; j++) {
+			if(adjMx(i, j)) {
+				succs[i].push_back(j);
+				preds[j].push_back(i);
+			}
+		}
+	}
 }
 
 void Project::computeELSFTs() {
@@ -514,6 +616,7 @@ void Project::complementPartialWithSSGS(const vector<int> &order, int startIx, v
 }
 
 Matrix<int> Project::normalCapacityProfile() const {
+	INSTR_COUNT(CAPACITY_PROFILE_ALLOCATIONS);
 	Matrix<int> resRem(numRes, numPeriods, [this](int r, int t) { return capacities[r]; });
 	return resRem;
 }
@@ -905,6 +1008,7 @@ void Project::updateDerivedParameters() {
 		reorderDispositionMethod();
 	T = accumulate(durations.begin(), durations.end(), 0);
 	numPeriods = T + 1;
+	computeAdjacencyLists();
 	topOrder = computeTopOrder();
 	revTopOrder = computeReverseTopOrder();
 	heuristicMaxMs = makespan(serialSGS(topOrder));
@@ -9,6 +9,7 @@
 #include "Matrix.h"
 
 #include <boost/filesystem/path.hpp>
+#include <memory>
 
 #define EACH_COMMON(ix, ubExcl, code) \
     for(int ix=0; ix<ubExcl; ix++) {\
@@ -56,6 +57,21 @@ struct SGSResult {
 	SGSResult() {}
 };
 
+// State of a serial SGS run before the activity list entry at position is scheduled
+struct SGSCheckpoint {
+	int position, lastFinish;
+	std::vector<int> sts;
+	Matrix<int> resRem;
+};
+
+// Checkpoints recorded while decoding order with overtime z, snapshots are shared between parent and offspring
+struct SGSCheckpoints {
+	std::vector<int> order;
+	Matrix<int> z;
+	std::vector<std::shared_ptr<const SGSCheckpoint>> snapshots;
+	int resumedPosition = 0;
+};
+
 struct JsonWrap {
 	json11::Json &obj;
 };
@@ -66,6 +82,7 @@ public:
 
     int numJobs, numRes, numPeriods, T, lastJob;
     Matrix<char> adjMx;
+	std::vector<std::vector<int>> preds, succs;
 	std::vector<int> durations, capacities;
     Matrix<int> demands;
 
@@ -87,6 +104,8 @@ public:
 	std::pair<std::vector<int>, Matrix<int>> serialSGSForPartial(const std::vector<int> &sts, const std::vector<int> &order) const;
 	SGSResult serialSGS(const std::vector<int>& order, const std::vector<int>& z, bool robust = false) const;
 	SGSResult serialSGS(const std::vector<int>& order, const Matrix<int>& z, bool robust = false) const;
+	SGSResult serialSGS(const std::vector<int>& order, const std::vector<int>& z, const SGSCheckpoints *previous, SGSCheckpoints &recorded, int numCheckpoints) const;
+	SGSResult serialSGS(const std::vector<int>& order, const Matrix<int>& z, const SGSCheckpoints *previous, SGSCheckpoints &recorded, int numCheckpoints) const;
 
 	std::vector<int> serialSGSWithRandomKey(const std::vector<float> &rk) const;
 	SGSResult serialSGSWithRandomKey(const std::vector<float>& rk, const std::vector<int>& z) const;
@@ -196,6 +215,8 @@ protected:
 
 	std::vector<int> serialSGSCore(const std::vector<int>& order, Matrix<int> &resRem, bool robust = false) const;
 	std::vector<int> serialSGSCoreWithRandomKey(const std::vector<float>& rk, Matrix<int>& resRem) const;
+	// previous may only be resumed at snapshots finishing before the first zAgreedPeriods periods end, resRem holds the capacities for the new z
+	std::vector<int> serialSGSCoreWithCheckpoints(const std::vector<int>& order, Matrix<int> &resRem, const SGSCheckpoints *previous, int zAgreedPeriods, SGSCheckpoints &recorded, int numCheckpoints) const;
 
     bool enoughCapacityForJob(int job, int t, const Matrix<int> & resRem) const;
 
@@ -242,12 +263,12 @@ private:
 
     void reorderDispositionMethod();
 
-	template <class Pred>
-	std::vector<int> topOrderComputationCore(Pred isEligible) const;
+	std::vector<int> topOrderComputationCore(const std::vector<std::vector<int>> &before, const std::vector<std::vector<int>> &after) const;
 	std::vector<int> computeTopOrder() const;
 	std::vector<int> computeReverseTopOrder() const;
 
     void computeELSFTs();
+	void computeAdjacencyLists();
 
     void computeNodeDepths(int root, int curDepth, std::vector<int> &nodeDepths);
 
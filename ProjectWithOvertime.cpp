@@ -12,7 +12,9 @@
 #include <boost/algorithm/string/join.hpp>
 
 #include "ProjectWithOvertime.h"
+#include "Bounds.h"
 #include "GurobiSolver.h"
+#include "Instrumentation.h"
 
 using namespace std;
 
@@ -154,6 +156,19 @@ int ProjectWithOvertime::heuristicMakespanUpperBound() const {
 	return ms;
 }
 
+// Maximum of critical path length and energy bound using maximum overtime
+int ProjectWithOvertime::makespanLowerBound() const {
+	return Bounds(*this).makespanLowerBound();
+}
+
+float ProjectWithOvertime::overtimeCostsLowerBound(int ms) const {
+	return Bounds(*this).overtimeCostsLowerBound(ms);
+}
+
+vector<float> ProjectWithOvertime::profitUpperBounds() const {
+	return Bounds(*this).profitUpperBounds();
+}
+
 SGSResult ProjectWithOvertime::forwardBackwardDeadlineOffsetSGS(const vector<int> &order, int deadlineOffset, bool robust) const {
 	auto baseSchedule = serialSGS(order, zmax, robust);
 	if(deadlineOffset <= 0) return baseSchedule;
@@ -166,6 +181,7 @@ SGSResult ProjectWithOvertime::forwardBackwardDeadlineOffsetSGS(const vector<int
 SGSResult ProjectWithOvertime::delayWithoutOvertimeIncrease(const vector<int>& order, const vector<int>& baseSts, const Matrix<int>& baseResRem, int deadline, bool robust) const {
 	vector<int> sts(baseSts);
 	Matrix<int> resRem(baseResRem);
+	INSTR_COUNT(CAPACITY_PROFILE_ALLOCATIONS);
 	vector<bool> unscheduled(numJobs, true);
 
 	sts[numJobs - 1] = deadline;
@@ -191,6 +207,7 @@ SGSResult ProjectWithOvertime::earlierWithoutOvertimeIncrease(const vector<int>&
 	vector<int> sts(baseSts);
 	vector<int> fts = stsToFts(sts);
 	Matrix<int> resRem(baseResRem);
+	INSTR_COUNT(CAPACITY_PROFILE_ALLOCATIONS);
 	vector<bool> unscheduled(numJobs, true);
 
 	sts[0] = fts[0] = 0;
@@ -483,6 +500,7 @@ SGSResult ProjectWithOvertime::serialSGSWithOvertimeWithForwardBackwardImproveme
 }
 
 bool ProjectWithOvertime::enoughCapacityForJobWithOvertime(int job, int t, const Matrix<int> & resRem) const {
+	INSTR_COUNT(CAPACITY_CHECKS);
     ACTIVE_PERIODS(job, t, EACH_RES(if(demands(job,r) > resRem(r,tau) + zmax[r]) return false))
     return true;
 }
@@ -569,6 +587,32 @@ SGSResult ProjectWithOvertime::serialSGSWithForwardBackwardImprovement(const vec
 	return forwardBackwardIterations(order, res, makespan(res), boost::optional<int>(), robust);
 }
 
+// (lambda, zr) resuming from the checkpoints inherited from the mother, replaced by the ones recorded for order
+SGSResult ProjectWithOvertime::serialSGSWithCheckpoints(const vector<int>& order, const vector<int>& z, shared_ptr<const SGSCheckpoints> &checkpoints, int numCheckpoints) const {
+	auto recorded = make_shared<SGSCheckpoints>();
+	SGSResult res = serialSGS(order, z, checkpoints.get(), *recorded, numCheckpoints);
+	checkpoints = recorded;
+	return res;
+}
+
+// (lambda, zrt) resuming from the checkpoints inherited from the mother, replaced by the ones recorded for order
+SGSResult ProjectWithOvertime::serialSGSWithCheckpoints(const vector<int>& order, const Matrix<int>& z, shared_ptr<const SGSCheckpoints> &checkpoints, int numCheckpoints) const {
+	auto recorded = make_shared<SGSCheckpoints>();
+	SGSResult res = serialSGS(order, z, checkpoints.get(), *recorded, numCheckpoints);
+	checkpoints = recorded;
+	return res;
+}
+
+SGSResult ProjectWithOvertime::serialSGSWithForwardBackwardImprovement(const vector<int>& order, const vector<int>& z, shared_ptr<const SGSCheckpoints> &checkpoints, int numCheckpoints) const {
+	SGSResult res = serialSGSWithCheckpoints(order, z, checkpoints, numCheckpoints);
+	return forwardBackwardIterations(order, res, makespan(res));
+}
+
+SGSResult ProjectWithOvertime::serialSGSWithForwardBackwardImprovement(const vector<int>& order, const Matrix<int>& z, shared_ptr<const SGSCheckpoints> &checkpoints, int numCheckpoints) const {
+	SGSResult res = serialSGSWithCheckpoints(order, z, checkpoints, numCheckpoints);
+	return forwardBackwardIterations(order, res, makespan(res));
+}
+
 SGSResult ProjectWithOvertime::serialSGSTimeWindowArbitrary(const vector<int> &order, const vector<float> &tau, bool robust) const {
 	Matrix<int> resRem = normalCapacityProfile();
 
@@ -618,6 +662,8 @@ SGSResult ProjectWithOvertime::forwardBackwardIterations(const vector<int> &orde
 		system("pause");
 	};*/
 
+	INSTR_TIME(FBI);
+
 	const int DEADLINE_IMPROVEMENT_TOLERANCE = 0;
 	float lastCosts = totalCosts(result.resRem);
 	int i;
@@ -633,6 +679,7 @@ SGSResult ProjectWithOvertime::forwardBackwardIterations(const vector<int> &orde
 		lastCosts = currentCosts;
 	}
 	result.numSchedulesGenerated += i;
+	INSTR_ADD(FBI_ITERATIONS, i);
 	return result;
 }
 
@@ -77,6 +77,10 @@ public:
 
 	SGSResult serialSGSWithForwardBackwardImprovement(const std::vector<int>& order, const std::vector<int>& z, bool robust = false) const;
 	SGSResult serialSGSWithForwardBackwardImprovement(const std::vector<int>& order, const Matrix<int>& z, bool robust = false) const;
+	SGSResult serialSGSWithCheckpoints(const std::vector<int>& order, const std::vector<int>& z, std::shared_ptr<const SGSCheckpoints> &checkpoints, int numCheckpoints) const;
+	SGSResult serialSGSWithCheckpoints(const std::vector<int>& order, const Matrix<int>& z, std::shared_ptr<const SGSCheckpoints> &checkpoints, int numCheckpoints) const;
+	SGSResult serialSGSWithForwardBackwardImprovement(const std::vector<int>& order, const std::vector<int>& z, std::shared_ptr<const SGSCheckpoints> &checkpoints, int numCheckpoints) const;
+	SGSResult serialSGSWithForwardBackwardImprovement(const std::vector<int>& order, const Matrix<int>& z, std::shared_ptr<const SGSCheckpoints> &checkpoints, int numCheckpoints) const;
 
 	SGSResult serialSGSWithRandomKeyAndFBI(const std::vector<float> &rk, const Matrix<int>& z) const;
 	SGSResult serialSGSWithRandomKeyAndFBI(const std::vector<float> &rk, const std::vector<int>& z) const;
@@ -88,6 +92,10 @@ public:
 
 	int heuristicMakespanUpperBound() const;
 
+	int makespanLowerBound() const;
+	float overtimeCostsLowerBound(int ms) const;
+	std::vector<float> profitUpperBounds() const;
+
 	SGSResult forwardBackwardDeadlineOffsetSGS(const std::vector<int> &order, int deadlineOffset, bool robust = false) const;
 	SGSResult delayWithoutOvertimeIncrease(const std::vector<int>& order, const std::vector<int>& baseSts, const Matrix<int>& baseResRem, int deadline, bool robust = false) const;
 	SGSResult earlierWithoutOvertimeIncrease(const std::vector<int>& order, const std::vector<int>& baseSts, const Matrix<int>& baseResRem, bool robust = false) const;
@@ -0,0 +1,187 @@
+#include "Propagator.h"
+#include "ProjectWithOvertime.h"
+#include "Utils.h"
+
+using namespace std;
+
+Propagator::Propagator(const ProjectWithOvertime &_p, int _deadline, bool _edgeFinding)
+	: p(_p), deadline(_deadline), edgeFinding(_edgeFinding), ests(_p.numJobs, 0), lsts(_p.numJobs), compulsoryDemand(_p.numRes, Utils::max(0, _deadline) + 1, 0),
+	  disjunctiveWith(_p.numJobs), consistent(true), profileChanged(false), queued(_p.numJobs, false) {
+
+	if(edgeFinding) {
+		for(int i = 0; i < p.numJobs; i++) {
+			for(int j = i + 1; j < p.numJobs; j++) {
+				if(p.durations[i] == 0 || p.durations[j] == 0 || p.adjMx(i, j) || p.adjMx(j, i)) continue;
+				for(int r = 0; r < p.numRes; r++) {
+					if(p.demands(i, r) + p.demands(j, r) > capacity(r)) {
+						disjunctiveWith[i].push_back(j);
+						disjunctiveWith[j].push_back(i);
+						break;
+					}
+				}
+			}
+		}
+	}
+
+	for(int j = 0; j < p.numJobs && consistent; j++) {
+		lsts[j] = deadline - p.durations[j];
+		consistent = ests[j] <= lsts[j] && addCompulsoryPart(j, 1);
+	}
+
+	if(consistent) {
+		for(int j = 0; j < p.numJobs; j++) {
+			queue.push_back(j);
+			queued[j] = true;
+		}
+		profileChanged = true;
+		consistent = propagate();
+		clearQueue();
+	}
+	trail.clear();
+}
+
+bool Propagator::fix(int j, int stj) {
+	fixMarks.emplace_back(trail.size(), consistent);
+	if(consistent) {
+		consistent = setWindow(j, Utils::max(ests[j], stj), Utils::min(lsts[j], stj)) && propagate();
+		clearQueue();
+	}
+	return consistent;
+}
+
+void Propagator::undo() {
+	const auto mark = fixMarks.back();
+	fixMarks.pop_back();
+	while(trail.size() > mark.first) {
+		const Change &change = trail.back();
+		addCompulsoryPart(change.j, -1);
+		ests[change.j] = change.est;
+		lsts[change.j] = change.lst;
+		addCompulsoryPart(change.j, 1);
+		trail.pop_back();
+	}
+	// the restored windows are a fixpoint again
+	profileChanged = false;
+	consistent = mark.second;
+}
+
+bool Propagator::fixPartial(const vector<int> &sts) {
+	for(int j = 0; j < p.numJobs; j++)
+		if(sts[j] != Project::UNSCHEDULED && !fix(j, sts[j]))
+			return false;
+	return consistent;
+}
+
+vector<int> Propagator::getLfts() const {
+	return Utils::constructVector<int>(p.numJobs, [this](int j) { return lsts[j] + p.durations[j]; });
+}
+
+int Propagator::capacity(int r) const {
+	return p.capacities[r] + p.zmax[r];
+}
+
+bool Propagator::setWindow(int j, int newEst, int newLst) {
+	if(newEst == ests[j] && newLst == lsts[j]) return true;
+	trail.push_back({ j, ests[j], lsts[j] });
+	addCompulsoryPart(j, -1);
+	ests[j] = newEst;
+	lsts[j] = newLst;
+	if(newEst > newLst) return false;
+	if(!queued[j]) {
+		queue.push_back(j);
+		queued[j] = true;
+	}
+	return addCompulsoryPart(j, 1);
+}
+
+bool Propagator::tightenEst(int j, int newEst) {
+	return newEst <= ests[j] || setWindow(j, newEst, lsts[j]);
+}
+
+bool Propagator::tightenLst(int j, int newLst) {
+	return newLst >= lsts[j] || setWindow(j, ests[j], newLst);
+}
+
+// Every start in the window occupies the periods (lst, est + duration], false if adding them overloads a resource
+bool Propagator::addCompulsoryPart(int j, int sign) {
+	if(ests[j] > lsts[j] || lsts[j] >= ests[j] + p.durations[j]) return true;
+	profileChanged = true;
+	bool feasible = true;
+	for(int r = 0; r < p.numRes; r++) {
+		if(p.demands(j, r) == 0) continue;
+		for(int tau = lsts[j] + 1; tau <= ests[j] + p.durations[j]; tau++) {
+			int &cdemand = compulsoryDemand(r, tau);
+			cdemand += sign * p.demands(j, r);
+			if(cdemand > capacity(r)) feasible = false;
+		}
+	}
+	return feasible;
+}
+
+// Whether j fits at stj next to the compulsory parts of the other jobs, otherwise the first overloaded period
+bool Propagator::fitsAt(int j, int stj, int &conflictPeriod) const {
+	for(int tau = stj + 1; tau <= stj + p.durations[j]; tau++) {
+		const bool ownPart = tau > lsts[j] && tau <= ests[j] + p.durations[j];
+		for(int r = 0; r < p.numRes; r++) {
+			if(p.demands(j, r) == 0) continue;
+			const int otherDemand = compulsoryDemand(r, tau) - (ownPart ? p.demands(j, r) : 0);
+			if(otherDemand + p.demands(j, r) > capacity(r)) {
+				conflictPeriod = tau;
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+bool Propagator::timeTable(int j) {
+	if(ests[j] == lsts[j] || p.durations[j] == 0) return true;
+
+	int stj = ests[j], conflictPeriod;
+	while(stj <= lsts[j] && !fitsAt(j, stj, conflictPeriod))
+		stj = conflictPeriod;
+	if(!tightenEst(j, stj)) return false;
+
+	stj = lsts[j];
+	while(stj >= ests[j] && !fitsAt(j, stj, conflictPeriod))
+		stj = conflictPeriod - p.durations[j] - 1;
+	return tightenLst(j, stj);
+}
+
+// Jobs i and j cannot overlap, so one has to finish before the other starts
+bool Propagator::disjunctivePair(int i, int j) {
+	const bool iFirstPossible = ests[i] + p.durations[i] <= lsts[j], jFirstPossible = ests[j] + p.durations[j] <= lsts[i];
+	if(!iFirstPossible && !jFirstPossible) return false;
+	if(!iFirstPossible) return tightenEst(i, ests[j] + p.durations[j]) && tightenLst(j, lsts[i] - p.durations[j]);
+	if(!jFirstPossible) return tightenEst(j, ests[i] + p.durations[i]) && tightenLst(i, lsts[j] - p.durations[i]);
+	return true;
+}
+
+// Precedence and edge-finding from the changed jobs, time-tabling of all jobs whenever a compulsory part changed
+bool Propagator::propagate() {
+	while(true) {
+		while(!queue.empty()) {
+			const int j = queue.front();
+			queue.pop_front();
+			queued[j] = false;
+			for(int k : p.succs[j])
+				if(!tightenEst(k, ests[j] + p.durations[j])) return false;
+			for(int i : p.preds[j])
+				if(!tightenLst(i, lsts[j] - p.durations[i])) return false;
+			for(int k : disjunctiveWith[j])
+				if(!disjunctivePair(j, k)) return false;
+		}
+
+		if(!profileChanged) return true;
+		profileChanged = false;
+		for(int j = 0; j < p.numJobs; j++)
+			if(!timeTable(j)) return false;
+	}
+}
+
+void Propagator::clearQueue() {
+	for(int j : queue)
+		queued[j] = false;
+	queue.clear();
+	profileChanged = false;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <vector>
+#include <deque>
+
+#include "Matrix.h"
+
+class ProjectWithOvertime;
+
+// Start time windows [est, lst] of all jobs of a project with overtime for schedules finishing by a deadline.
+// Windows are tightened to a fixpoint by precedence, by time-tabling against the compulsory parts of all jobs
+// with the capacities extended by zmax and optionally by edge-finding on pairs of jobs that can never overlap.
+// Fixing a job re-propagates from the changed windows, fixes are undone in reverse order.
+class Propagator {
+public:
+	Propagator(const ProjectWithOvertime &_p, int _deadline, bool _edgeFinding = false);
+
+	// Fixes job j to start at stj and propagates, false if some window becomes empty
+	bool fix(int j, int stj);
+	// Restores the windows before the last fix
+	void undo();
+	// Fixes the scheduled jobs of a partial schedule
+	bool fixPartial(const std::vector<int> &sts);
+
+	// False if no schedule with makespan at most the deadline completes the fixed jobs
+	bool isConsistent() const { return consistent; }
+	int est(int j) const { return ests[j]; }
+	int lst(int j) const { return lsts[j]; }
+	const std::vector<int> &getEsts() const { return ests; }
+	std::vector<int> getLfts() const;
+	int getDeadline() const { return deadline; }
+
+private:
+	const ProjectWithOvertime &p;
+	const int deadline;
+	const bool edgeFinding;
+	std::vector<int> ests, lsts;
+	// Demand of the compulsory parts (lst, est + duration] of all jobs per resource and period
+	Matrix<int> compulsoryDemand;
+	// Pairs of jobs whose demands exceed the extended capacity of some resource together
+	std::vector<std::vector<int>> disjunctiveWith;
+	bool consistent, profileChanged;
+
+	// Window of a job before it was changed, fixes remember the trail size and consistency before them
+	struct Change {
+		int j, est, lst;
+	};
+	std::vector<Change> trail;
+	std::vector<std::pair<size_t, bool>> fixMarks;
+
+	std::deque<int> queue;
+	std::vector<bool> queued;
+
+	int capacity(int r) const;
+	bool setWindow(int j, int newEst, int newLst);
+	bool tightenEst(int j, int newEst);
+	bool tightenLst(int j, int newLst);
+	bool addCompulsoryPart(int j, int sign);
+	bool fitsAt(int j, int stj, int &conflictPeriod) const;
+	bool timeTable(int j);
+	bool disjunctivePair(int i, int j);
+	bool propagate();
+	void clearQueue();
+};
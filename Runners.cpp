@@ -23,7 +23,7 @@ using namespace std;
 		sw.start(); \
 		auto pair = ga.solve(); \
 		double solvetime = sw.look(); \
-		return{ pair.first, pair.second, solvetime, ga.getName() }; \
+		return{ pair.first, pair.second, solvetime, ga.getName(), ga.anytimeCurve() }; \
 	}
 
 namespace Runners {
@@ -135,14 +135,9 @@ namespace Runners {
 	}
 
 
-	vector<int> runGeneticAlgorithmWithIndex(ProjectWithOvertime &p, RunnerParams rparams) {
+	GAParameters defaultParameters() {
 		GAParameters params;
 
-		params.traceobj = rparams.traceobj;
-		params.timeLimit = rparams.timeLimit;
-		params.iterLimit = rparams.iterLimit;
-		params.outPath = rparams.outPath;
-
 		params.fitnessBasedPairing = false;
 		params.rbbrs = true;
 		params.fbiFeedbackInjection = false;
@@ -157,6 +152,17 @@ namespace Runners {
 		params.sgs = ScheduleGenerationScheme::SERIAL;
 		params.crossoverMethod = CrossoverMethod::OPC;
 
+		return params;
+	}
+
+	vector<int> runGeneticAlgorithmWithIndex(ProjectWithOvertime &p, RunnerParams rparams) {
+		GAParameters params = defaultParameters();
+
+		params.traceobj = rparams.traceobj;
+		params.timeLimit = rparams.timeLimit;
+		params.iterLimit = rparams.iterLimit;
+		params.outPath = rparams.outPath;
+
 		params.from_disk("GAParameters.json", true);
 
 		params.print();
@@ -22,8 +22,10 @@ namespace Runners {
 		float profit;
 		double solvetime;
 		std::string name;
+		std::vector<Utils::Tracer::TracePoint> anytimeCurve;
 	};
 
+	GAParameters defaultParameters();
 	GAResult run(ProjectWithOvertime &p, GAParameters &params, int index);
 
 	std::string getDescription(int index);
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <boost/filesystem.hpp>
+
+// Switches the working directory to a fresh temporary directory and removes it again on destruction.
+// Genetic algorithms and searches write trace, improvement time and checkpoint files relative to the working directory.
+class ScopedTempWorkingDirectory {
+public:
+	ScopedTempWorkingDirectory() : previous(boost::filesystem::current_path()), temp(boost::filesystem::temp_directory_path() / boost::filesystem::unique_path()) {
+		boost::filesystem::create_directories(temp);
+		boost::filesystem::current_path(temp);
+	}
+	~ScopedTempWorkingDirectory() {
+		boost::filesystem::current_path(previous);
+		boost::filesystem::remove_all(temp);
+	}
+private:
+	boost::filesystem::path previous, temp;
+};
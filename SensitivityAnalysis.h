@@ -34,22 +34,26 @@ namespace sensitivity {
 		params.enforceTopOrdering = true;
 		params.traceobj = false;
 
+#ifndef DISABLE_GUROBI
 		GurobiSolver::Options opts;
 		opts.timeLimit = GRB_INFINITY;
 		opts.threadCount = 0;
 		opts.saveTimeForBks = false;
 		opts.traceobj = false;
+#endif
 
 		float v = from;
 		while (v <= to) {
 			modifier(&p, v);
-			//FixedCapacityGA ga(p);
-			//ga.setParameters(params);
-			//res.push_back({v, ga.solve().first});
-
+#ifndef DISABLE_GUROBI
 			GurobiSolver gsolver(p, opts);
 			gsolver.buildModel();
 			res.push_back({v, gsolver.solve().sts});
+#else
+			FixedCapacityGA ga(p);
+			ga.setParameters(params);
+			res.push_back({v, ga.solve().first});
+#endif
 			v += step;
 		}
 		return res;
@@ -0,0 +1,87 @@
+#include <algorithm>
+#include <stdexcept>
+
+#include "TranspositionTable.h"
+
+using namespace std;
+
+TranspositionTable::TranspositionTable(size_t budgetBytes)
+	: numBuckets(max<size_t>(1, budgetBytes / (sizeof(Entry) * BUCKET_SIZE))), locks(NUM_LOCKS),
+	  lookups(0), hits(0), prunes(0), stores(0), replacements(0) {
+	entries.assign(numBuckets * BUCKET_SIZE, { 0, 0, 0.0f, -1 });
+}
+
+bool TranspositionTable::isDominated(const Key &key, float cost, int depth) {
+	const size_t bucket = key.hash % numBuckets;
+	Entry *first = &entries[bucket * BUCKET_SIZE];
+	lookups.fetch_add(1, memory_order_relaxed);
+
+	lock_guard<mutex> lock(locks[bucket % NUM_LOCKS]);
+
+	Entry *victim = first;
+	for(Entry *entry = first; entry != first + BUCKET_SIZE; entry++) {
+		if(entry->depth != -1 && entry->hash == key.hash && entry->check == key.check) {
+			hits.fetch_add(1, memory_order_relaxed);
+			if(entry->cost <= cost) {
+				prunes.fetch_add(1, memory_order_relaxed);
+				return true;
+			}
+			entry->cost = cost;
+			return false;
+		}
+		if(victim->depth != -1 && (entry->depth == -1 || entry->depth > victim->depth))
+			victim = entry;
+	}
+
+	if(victim->depth != -1)
+		replacements.fetch_add(1, memory_order_relaxed);
+	stores.fetch_add(1, memory_order_relaxed);
+	*victim = { key.hash, key.check, cost, depth };
+	return false;
+}
+
+void TranspositionTable::forget(const Key &key) {
+	const size_t bucket = key.hash % numBuckets;
+	Entry *first = &entries[bucket * BUCKET_SIZE];
+	lock_guard<mutex> lock(locks[bucket % NUM_LOCKS]);
+	for(Entry *entry = first; entry != first + BUCKET_SIZE; entry++)
+		if(entry->depth != -1 && entry->hash == key.hash && entry->check == key.check)
+			entry->depth = -1;
+}
+
+void TranspositionTable::save(Checkpoint::Writer &writer) const {
+	writer.put<uint64_t>(entries.size());
+	const Statistics stats = getStatistics();
+	writer.put(stats);
+
+	writer.put<uint64_t>(static_cast<uint64_t>(count_if(entries.begin(), entries.end(), [](const Entry &e) { return e.depth != -1; })));
+	for(size_t i = 0; i < entries.size(); i++) {
+		if(entries[i].depth == -1) continue;
+		writer.put<uint64_t>(i);
+		writer.put(entries[i]);
+	}
+}
+
+void TranspositionTable::load(Checkpoint::Reader &reader) {
+	if(reader.get<uint64_t>() != entries.size())
+		throw runtime_error("Transposition table of checkpoint has a different capacity");
+	const Statistics stats = reader.get<Statistics>();
+	lookups = stats.lookups;
+	hits = stats.hits;
+	prunes = stats.prunes;
+	stores = stats.stores;
+	replacements = stats.replacements;
+
+	entries.assign(entries.size(), { 0, 0, 0.0f, -1 });
+	const uint64_t numOccupied = reader.get<uint64_t>();
+	for(uint64_t k = 0; k < numOccupied; k++) {
+		const uint64_t i = reader.get<uint64_t>();
+		if(i >= entries.size())
+			throw runtime_error("Transposition table entry of checkpoint out of range");
+		entries[i] = reader.get<Entry>();
+	}
+}
+
+TranspositionTable::Statistics TranspositionTable::getStatistics() const {
+	return { lookups.load(), hits.load(), prunes.load(), stores.load(), replacements.load() };
+}
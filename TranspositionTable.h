@@ -0,0 +1,50 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "Checkpoint.h"
+
+// Fixed size hash table of the best partial costs seen for search states, shared by all search threads.
+// States are identified by two independent 64 bit hashes, a full collision of both is ignored.
+class TranspositionTable {
+public:
+	struct Key {
+		uint64_t hash, check;
+	};
+
+	struct Statistics {
+		long long lookups, hits, prunes, stores, replacements;
+	};
+
+	explicit TranspositionTable(size_t budgetBytes);
+
+	// True if a state with equal key and lower or equal cost was stored, otherwise stores cost for the key.
+	// A full bucket replaces its deepest entry since deep states root the smallest subtrees.
+	bool isDominated(const Key &key, float cost, int depth);
+	// Drops the entry of key, e.g. for a state stored by a visit that was aborted before its subtree was searched
+	void forget(const Key &key);
+
+	// Occupied entries and statistics, loading requires a table of equal capacity
+	void save(Checkpoint::Writer &writer) const;
+	void load(Checkpoint::Reader &reader);
+
+	Statistics getStatistics() const;
+	size_t getCapacity() const { return entries.size(); }
+
+private:
+	struct Entry {
+		uint64_t hash, check;
+		float cost;
+		int depth;
+	};
+
+	static const int BUCKET_SIZE = 4, NUM_LOCKS = 256;
+
+	std::vector<Entry> entries;
+	size_t numBuckets;
+	std::vector<std::mutex> locks;
+	std::atomic<long long> lookups, hits, prunes, stores, replacements;
+};
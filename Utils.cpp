@@ -79,6 +79,20 @@ void Utils::serializeProfit(float profit, const string &filename) {
 	spit(std::to_string(profit), filename);
 }
 
+std::mt19937 &Utils::randomEngine() {
+	thread_local std::mt19937 engine(static_cast<unsigned int>(rand()));
+	return engine;
+}
+
+void Utils::seedRandomEngine(unsigned int seed) {
+	randomEngine().seed(seed);
+}
+
+void Utils::seedRandom(unsigned int seed) {
+	srand(seed);
+	seedRandomEngine(seed);
+}
+
 int Utils::pickWithDistribution(vector<float> &probs, float q) {
 	float cumulatedProbs = 0.0f;
 	int lastPossibleIx = 0;
@@ -134,17 +148,19 @@ void Utils::spitAppend(const string &s, const string &filename) {
 }
 
 
-string Utils::formattedNow() {
-	time_t rawtime;
+string Utils::formattedTime(time_t rawtime) {
 	struct tm* timeinfo;
 	char buffer[80];
-	time(&rawtime);
 	timeinfo = localtime(&rawtime);
 	strftime(buffer, 80, "%d-%m-%Y %I:%M:%S", timeinfo);
 	string str(buffer);
 	return str;
 }
 
+string Utils::formattedNow() {
+	return formattedTime(time(nullptr));
+}
+
 void Utils::partitionDirectory(const string& dirPath, int numPartitions, const string& infix) {
 	if(!boost::filesystem::exists(dirPath)) {
 		LOG_W("Unable to partition directory " + dirPath + ", it does not exist!");
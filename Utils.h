@@ -10,6 +10,7 @@
 #include <fstream>
 #include <chrono>
 #include <numeric>
+#include <random>
 
 #include <boost/format.hpp>
 #include <boost/algorithm/string/split.hpp>
@@ -17,10 +18,7 @@
 
 #include "Stopwatch.h"
 #include "Matrix.h"
-
-#define LOG_I(msg) Utils::Logger::getInstance()->log(Utils::Logger::LogLevel::INFO, msg)
-#define LOG_W(msg) Utils::Logger::getInstance()->log(Utils::Logger::LogLevel::WARNING, msg)
-#define LOG_E(msg) Utils::Logger::getInstance()->log(Utils::Logger::LogLevel::ERROR, msg)
+#include "Logger.h"
 
 namespace Utils {
 	std::string slurp(const std::string &filename);
@@ -41,16 +39,22 @@ namespace Utils {
 	void serializeSchedule(const std::vector<int> &sts, const std::string &filename);
 	void serializeProfit(float profit, const std::string &filename);
 
+	// Per-thread random stream, seeded from rand() on first use unless a thread seeds it explicitly
+	std::mt19937 &randomEngine();
+	void seedRandomEngine(unsigned int seed);
+	// Seeds rand() and the calling thread's random stream, so single-threaded runs repeat for a fixed seed
+	void seedRandom(unsigned int seed);
+
     inline bool randBool() {
-        return rand() % 2 == 0;
+        return randomEngine()() % 2 == 0;
     }
 
     inline int randRangeIncl(int lb, int ub) {
-        return lb + rand() % (ub-lb+1);
+        return lb + static_cast<int>(randomEngine()() % static_cast<unsigned int>(ub-lb+1));
     }
 
     inline float randUnitFloat() {
-        return static_cast<float>(rand()) / static_cast<float>(RAND_MAX);
+        return static_cast<float>(randomEngine()()) / static_cast<float>(std::mt19937::max());
     }
 
     int pickWithDistribution(std::vector<float> &probs, float q = randUnitFloat());
@@ -143,6 +147,7 @@ namespace Utils {
 		return b ? 1 : 0;
 	}
 
+	std::string formattedTime(time_t rawtime);
 	std::string formattedNow();
 
 	void partitionDirectory(const std::string& dirPath, int numPartitions, const std::string& infix = "_");
@@ -8,6 +8,9 @@
 
 #include "Runners.h"
 #include "BranchAndBound.h"
+#include "NodeLog.h"
+#include "BenchmarkDriver.h"
+#include "InstanceGenerator.h"
 #include "GurobiSolver.h"
 #include "Utils.h"
 
@@ -346,11 +349,14 @@ void Main::convertArgFileToLSP(int argc, const char * argv[]) {
 }
 
 void Main::showUsage() {
-	list<string> solMethods = { "BranchAndBound", "LocalSolver", "Gurobi" };
+	list<string> solMethods = { "BranchAndBound", "BranchAndBoundN // parallel with N threads", "BranchAndBoundBestFirst", "BranchAndBoundBeamW // beam width W", "BranchAndBoundLDSK // up to K discrepancies", "LocalSolver", "Gurobi" };
 	for (int i = 0; i < 12; i++) solMethods.push_back("GA" + to_string(i) + " // " + Runners::getDescription(i));
 	for (int i = 0; i < 11; i++) solMethods.push_back("LocalSolverNative" + to_string(i) + " // " + Runners::getDescription(i));
 	cout << "Number of arguments must be >= 4" << endl;
-	cout << "Usage: Solver SolutionMethod TimeLimitInSecs ScheduleLimit ProjectFileSM [traceobj]" << endl;
+	cout << "Usage: Solver SolutionMethod TimeLimitInSecs ScheduleLimit ProjectFileSM [traceobj] [nodelog] [checkpoint]" << endl;
+	cout << "   or: Solver Benchmark BenchmarkConfig.json" << endl;
+	cout << "   or: Solver Generate GeneratorParameters.json OutFile.sm|OutFile.json" << endl;
+	cout << "   or: Solver ConvertNodeLog NodeLog.bin OutFile.dot|OutFile.csv" << endl;
 	cout << "Solution methods: " << endl;
 	for (const auto &method : solMethods) cout << "\t" << method << endl;
 }
@@ -385,6 +391,23 @@ void Main::purgeOldTraceFile(const string &traceFilename) {
 }
 
 void Main::commandLineRunner(int argc, const char * argv[]) {
+	if(argc == 3 && string(argv[1]) == "Benchmark") {
+		BenchmarkDriver::runFromConfigFile(argv[2]);
+		return;
+	}
+
+	if(argc == 4 && string(argv[1]) == "Generate") {
+		InstanceGenerator::GeneratorParameters params;
+		params.from_disk(argv[2]);
+		InstanceGenerator::generateToDisk(params, argv[3]);
+		return;
+	}
+
+	if(argc == 4 && string(argv[1]) == "ConvertNodeLog") {
+		NodeLog::convert(argv[2], argv[3]);
+		return;
+	}
+
     if(argc >= 4) {
 		vector<int> sts;
 
@@ -393,13 +416,15 @@ void Main::commandLineRunner(int argc, const char * argv[]) {
 		int iterLimit = atoi(argv[3]);
         ProjectWithOvertime p(argv[4]);
 
-	    bool traceobj, quiet, timeforbks, info, noskip;
+	    bool traceobj, quiet, timeforbks, info, noskip, nodelog, checkpoint;
         map<string, bool *> lastParameterToggles = {
         		{"traceobj", &traceobj },
         		{"quiet", &quiet },
         		{"timeforbks", &timeforbks },
 				{"info", &info},
-				{"noskip", &noskip}
+				{"noskip", &noskip},
+				{"nodelog", &nodelog},
+				{"checkpoint", &checkpoint}
         };
 
 		for (const auto &pair : lastParameterToggles) {
@@ -426,11 +451,15 @@ void Main::commandLineRunner(int argc, const char * argv[]) {
 		boost::filesystem::create_directory(boost::filesystem::path(outPath));
 		const string coreName = Project::coreInstanceName(parentPath, string(argv[4]));
 
-		srand(23);
+		Utils::seedRandom(23);
 
-		if(solMethod == "BranchAndBound") {
-            BranchAndBound b(p, timeLimit, iterLimit);
-			outFn += "BranchAndBoundResults.txt";
+		if(boost::starts_with(solMethod, "BranchAndBound")) {
+			int threadCount;
+			const auto strategy = BranchAndBound::strategyFromSuffix(solMethod.substr(14), threadCount);
+            BranchAndBound b(p, timeLimit, iterLimit, nodelog, threadCount);
+			b.setStrategy(strategy);
+			if(checkpoint) b.setCheckpoint(BranchAndBound::getCheckpointFilename(outPath, p.instanceName));
+			outFn += (strategy.type == BranchAndBound::Strategy::DepthFirst ? "BranchAndBound" : solMethod) + "Results.txt";
 			if(instanceAlreadySolvedInResultFile(coreName, outFn)) return;
 			purgeOldTraceFile(BranchAndBound::getTraceFilename(outPath, p.instanceName));
             sts = b.solve(false, traceobj, outPath);			
@@ -652,7 +681,7 @@ void solveAndvalidateGAResult(const ProjectWithOvertime &p, const std::string &i
 	sw.start();
 	const auto pair = ga.solve();
 	const double solvetime = sw.look();
-	const Runners::GAResult result = { pair.first, pair.second, solvetime, ga.getName() };
+	const Runners::GAResult result = { pair.first, pair.second, solvetime, ga.getName(), ga.anytimeCurve() };
 	LOG_I("Representation=" + result.name + " Profit=" + to_string(result.profit) + " Solvetime=" + to_string(result.solvetime));
 	LOG_I("Actual profit = " + to_string(p.calcProfit(pair.first)));
 	assert(p.isScheduleFeasible(pair.first));